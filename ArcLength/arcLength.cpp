@@ -0,0 +1,174 @@
+//
+// Arc-length reparameterization of Bezier and Hermite curves.
+//
+
+#include "arcLength.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Gauss-Legendre nodes and weights on [-1, 1], the 5 points rule
+static const long double GAUSS_LEGENDRE_NODES[5] = {
+        -0.906179845938663992797626878299392965L,
+        -0.538469310105683091036314420700208805L,
+        0.0L,
+        0.538469310105683091036314420700208805L,
+        0.906179845938663992797626878299392965L
+};
+
+static const long double GAUSS_LEGENDRE_WEIGHTS[5] = {
+        0.236926885056189087514264040719917363L,
+        0.478628670499366468041291514835638192L,
+        0.568888888888888888888888888888888889L,
+        0.478628670499366468041291514835638192L,
+        0.236926885056189087514264040719917363L
+};
+
+template<typename T>
+static std::vector<Vec3T<T> > Hodograph(const std::vector<Vec3T<T> > &controlPoints) {
+    std::vector<Vec3T<T> > hodograph;
+
+    if (controlPoints.size() < 2) {
+        hodograph.push_back(Vec3T<T>(0, 0, 0));
+        return hodograph;
+    }
+
+    T degree = (T) (controlPoints.size() - 1);
+
+    for (size_t i = 0; i + 1 < controlPoints.size(); i++) {
+        hodograph.push_back(degree * (controlPoints[i + 1] - controlPoints[i]));
+    }
+
+    return hodograph;
+}
+
+template<typename T>
+T BezierArcLength(const std::vector<Vec3T<T> > &hodograph, const typename NonDeduced<T>::type u0,
+                  const typename NonDeduced<T>::type u1) {
+    T halfWidth = (u1 - u0) / 2;
+    T middle = (u0 + u1) / 2;
+    T length = 0;
+
+    for (int i = 0; i < 5; i++) {
+        T u = middle + halfWidth * (T) GAUSS_LEGENDRE_NODES[i];
+        length += (T) GAUSS_LEGENDRE_WEIGHTS[i] * BezierPointByCasteljau(hodograph, u).length();
+    }
+
+    return length * halfWidth;
+}
+
+template<typename T>
+ArcLengthTableT<T>::ArcLengthTableT(const std::vector<Vec3T<T> > &controlPoints)
+        : mControlPoints(controlPoints) {
+    build();
+}
+
+template<typename T>
+ArcLengthTableT<T>::ArcLengthTableT(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0,
+                                    const Vec3T<T> &v1)
+        : mControlPoints(4) {
+    HermiteToBezier(p0, p1, v0, v1, mControlPoints.data());
+
+    build();
+}
+
+template<typename T>
+void ArcLengthTableT<T>::build() {
+    mHodograph = Hodograph(mControlPoints);
+    mLengths[0] = 0;
+
+    for (size_t i = 0; i < ARC_LENGTH_TABLE_SIZE; i++) {
+        T u0 = (T) i / ARC_LENGTH_TABLE_SIZE;
+        T u1 = (T) (i + 1) / ARC_LENGTH_TABLE_SIZE;
+
+        mLengths[i + 1] = mLengths[i] + BezierArcLength(mHodograph, u0, u1);
+    }
+}
+
+template<typename T>
+T ArcLengthTableT<T>::lengthAt(T u) const {
+    u = std::min(std::max(u, (T) 0), (T) 1);
+
+    size_t interval = std::min((size_t) (u * ARC_LENGTH_TABLE_SIZE), ARC_LENGTH_TABLE_SIZE - 1);
+    T start = (T) interval / ARC_LENGTH_TABLE_SIZE;
+
+    return mLengths[interval] + BezierArcLength(mHodograph, start, u);
+}
+
+template<typename T>
+T ArcLengthTableT<T>::parameterAt(T s) const {
+    if (s <= 0) {
+        return 0;
+    }
+
+    if (s >= length()) {
+        return 1;
+    }
+
+    // First interval whose end lies past s
+    size_t interval = (size_t) (std::upper_bound(mLengths + 1, mLengths + ARC_LENGTH_TABLE_SIZE + 1, s) - mLengths) - 1;
+    interval = std::min(interval, ARC_LENGTH_TABLE_SIZE - 1);
+
+    T start = (T) interval / ARC_LENGTH_TABLE_SIZE;
+    T end = (T) (interval + 1) / ARC_LENGTH_TABLE_SIZE;
+    T intervalLength = mLengths[interval + 1] - mLengths[interval];
+
+    if (intervalLength <= 0) {
+        return start;
+    }
+
+    T u = start + (end - start) * (s - mLengths[interval]) / intervalLength;
+
+    for (int step = 0; step < ARC_LENGTH_NEWTON_STEPS; step++) {
+        T speed = BezierPointByCasteljau(mHodograph, u).length();
+
+        if (speed <= 0) {
+            break;
+        }
+
+        T error = mLengths[interval] + BezierArcLength(mHodograph, start, u) - s;
+
+        // Length is monotonic, the root stays inside the interval
+        u = std::min(std::max(u - error / speed, start), end);
+    }
+
+    return u;
+}
+
+template<typename T>
+Vec3T<T> ArcLengthTableT<T>::point(T u) const {
+    return BezierPointByCasteljau(mControlPoints, u);
+}
+
+template<typename T>
+std::vector<Vec3T<T> > ArcLengthTableT<T>::curve(long nbPoints) const {
+    std::vector<Vec3T<T> > points;
+
+    if (nbPoints <= 0) {
+        return points;
+    }
+
+    if (nbPoints == 1) {
+        points.push_back(point(0));
+        return points;
+    }
+
+    points.reserve(nbPoints);
+
+    for (long i = 0; i < nbPoints; i++) {
+        T s = length() * (T) i / (T) (nbPoints - 1);
+        points.push_back(point(parameterAt(s)));
+    }
+
+    return points;
+}
+
+#define INSTANTIATE_ARC_LENGTH(T) \
+    template T BezierArcLength<T>(const std::vector<Vec3T<T> > &, T, T); \
+    template class ArcLengthTableT<T>;
+
+INSTANTIATE_ARC_LENGTH(float)
+INSTANTIATE_ARC_LENGTH(double)
+INSTANTIATE_ARC_LENGTH(long double)
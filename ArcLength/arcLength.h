@@ -0,0 +1,64 @@
+//
+// Arc-length reparameterization of Bezier and Hermite curves.
+//
+
+#ifndef MODELISATION_TP1_ARCLENGTH_H
+#define MODELISATION_TP1_ARCLENGTH_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+
+// Intervals of the cumulative length table, uniform in u.
+// The table holds ARC_LENGTH_TABLE_SIZE + 1 scalars, 132 bytes in float; the object also keeps heap
+// copies of the control points, for point(), and of the hodograph, for the quadrature.
+static const size_t ARC_LENGTH_TABLE_SIZE = 32;
+
+// Newton steps refining u after the table lookup.
+static const int ARC_LENGTH_NEWTON_STEPS = 2;
+
+// Length of the curve between two parameters by 5 points Gauss-Legendre quadrature of the speed
+// |hodograph(u)|. The rule is exact for polynomials up to degree 9, but the speed is the square root
+// of a polynomial and is only polynomial itself when the hodograph keeps a fixed direction, as on a
+// straight line without turning back. Elsewhere the error falls off like (u1 - u0)^11 times the 10th
+// derivative of the speed, which grows large where the speed comes close to 0, near a cusp.
+template<typename T>
+T BezierArcLength(const std::vector<Vec3T<T> > &hodograph, typename NonDeduced<T>::type u0,
+                  typename NonDeduced<T>::type u1);
+
+// Cumulative arc length table of a curve, built once, mapping a length s in [0, length()]
+// back to the parameter u.
+template<typename T>
+class ArcLengthTableT {
+public:
+    // Bezier curve of any degree.
+    explicit ArcLengthTableT(const std::vector<Vec3T<T> > &controlPoints);
+
+    // Cubic Hermite, converted to its Bezier form.
+    ArcLengthTableT(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1);
+
+    T length() const { return mLengths[ARC_LENGTH_TABLE_SIZE]; }
+
+    // Length from u = 0 to u.
+    T lengthAt(T u) const;
+
+    // u such that lengthAt(u) = s: table lookup, linear guess inside the interval and
+    // Newton steps on lengthAt(u) - s, whose derivative is the speed.
+    T parameterAt(T s) const;
+
+    Vec3T<T> point(T u) const;
+
+    // nbPoints points equally spaced by arc length, from the first to the last control point.
+    std::vector<Vec3T<T> > curve(long nbPoints) const;
+
+private:
+    void build();
+
+    std::vector<Vec3T<T> > mControlPoints;
+    std::vector<Vec3T<T> > mHodograph;
+    T mLengths[ARC_LENGTH_TABLE_SIZE + 1];
+};
+
+typedef ArcLengthTableT<float> ArcLengthTable;
+
+#endif //MODELISATION_TP1_ARCLENGTH_H
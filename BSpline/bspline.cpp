@@ -0,0 +1,375 @@
+//
+// B-spline and NURBS curves: de Boor evaluation, Boehm knot insertion, Bezier extraction.
+//
+
+#include "bspline.h"
+#include "../Casteljau/casteljau.h"
+#include "../Simd/simd.h"
+
+#include <algorithm>
+
+template<typename T>
+std::vector<T> ClampedUniformKnots(size_t nbPoints, size_t degree) {
+    assert(nbPoints > degree);
+
+    std::vector<T> knots(nbPoints + degree + 1);
+    size_t nbSpans = nbPoints - degree;
+
+    for (size_t i = 0; i < knots.size(); i++) {
+        if (i <= degree) {
+            knots[i] = 0;
+        } else if (i >= nbPoints) {
+            knots[i] = 1;
+        } else {
+            knots[i] = (T) (i - degree) / (T) nbSpans;
+        }
+    }
+
+    return knots;
+}
+
+template<typename T>
+BSplineT<T>::BSplineT(size_t degree, const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &knots)
+        : mDegree(degree), mPoints(controlPoints), mKnots(knots) {
+    assert(controlPoints.size() > degree);
+    assert(knots.size() == controlPoints.size() + degree + 1);
+}
+
+template<typename T>
+BSplineT<T>::BSplineT(size_t degree, const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &knots,
+                      const std::vector<T> &weights)
+        : mDegree(degree), mPoints(controlPoints), mKnots(knots), mWeights(weights) {
+    assert(controlPoints.size() > degree);
+    assert(knots.size() == controlPoints.size() + degree + 1);
+    assert(weights.size() == controlPoints.size());
+}
+
+template<typename T>
+size_t BSplineT<T>::findSpan(T t) const {
+    // First knot past t among knots[degree + 1] to knots[nbPoints - 1]
+    typename std::vector<T>::const_iterator after = std::upper_bound(mKnots.begin() + mDegree + 1,
+                                                                     mKnots.begin() + mPoints.size(), t);
+
+    return (size_t) (after - mKnots.begin()) - 1;
+}
+
+template<typename T>
+Vec3T<T> BSplineT<T>::point(T t) const {
+    size_t p = mDegree;
+    size_t k = findSpan(t);
+    bool rational = isRational();
+
+    Vec3T<T> stackPoints[BSPLINE_STACK_DEGREE + 1];
+    T stackWeights[BSPLINE_STACK_DEGREE + 1];
+    std::vector<Vec3T<T> > heapPoints;
+    std::vector<T> heapWeights;
+    Vec3T<T> *d = stackPoints;
+    T *w = stackWeights;
+
+    if (p > BSPLINE_STACK_DEGREE) {
+        heapPoints.resize(p + 1);
+        heapWeights.resize(p + 1);
+        d = heapPoints.data();
+        w = heapWeights.data();
+    }
+
+    for (size_t j = 0; j <= p; j++) {
+        size_t i = j + k - p;
+
+        if (rational) {
+            d[j] = mWeights[i] * mPoints[i];
+            w[j] = mWeights[i];
+        } else {
+            d[j] = mPoints[i];
+        }
+    }
+
+    for (size_t r = 1; r <= p; r++) {
+        for (size_t j = p; j >= r; j--) {
+            size_t i = j + k - p;
+            T alpha = (t - mKnots[i]) / (mKnots[i + p + 1 - r] - mKnots[i]);
+
+            d[j] = Vec3T<T>::lerp(d[j - 1], d[j], alpha);
+
+            if (rational) {
+                w[j] = w[j - 1] + (w[j] - w[j - 1]) * alpha;
+            }
+        }
+    }
+
+    return rational ? d[p] / w[p] : d[p];
+}
+
+template<typename T>
+void BSplineT<T>::insertKnot(T t) {
+    size_t p = mDegree;
+    size_t k = findSpan(t);
+    bool rational = isRational();
+
+    std::vector<Vec3T<T> > points(mPoints.size() + 1);
+    std::vector<T> weights(rational ? mWeights.size() + 1 : 0);
+
+    for (size_t i = 0; i < points.size(); i++) {
+        if (i + p <= k) {
+            points[i] = rational ? mWeights[i] * mPoints[i] : mPoints[i];
+            if (rational) {
+                weights[i] = mWeights[i];
+            }
+        } else if (i > k) {
+            points[i] = rational ? mWeights[i - 1] * mPoints[i - 1] : mPoints[i - 1];
+            if (rational) {
+                weights[i] = mWeights[i - 1];
+            }
+        } else {
+            // Points i - 1 and i of the old polygon, cut at t
+            T alpha = (t - mKnots[i]) / (mKnots[i + p] - mKnots[i]);
+
+            if (rational) {
+                points[i] = alpha * (mWeights[i] * mPoints[i]) + (1 - alpha) * (mWeights[i - 1] * mPoints[i - 1]);
+                weights[i] = alpha * mWeights[i] + (1 - alpha) * mWeights[i - 1];
+            } else {
+                points[i] = alpha * mPoints[i] + (1 - alpha) * mPoints[i - 1];
+            }
+        }
+    }
+
+    if (rational) {
+        for (size_t i = 0; i < points.size(); i++) {
+            points[i] /= weights[i];
+        }
+
+        mWeights.swap(weights);
+    }
+
+    mPoints.swap(points);
+    mKnots.insert(mKnots.begin() + k + 1, t);
+}
+
+template<typename T>
+BezierSegmentsT<T> BSplineT<T>::bezierSegments() const {
+    size_t p = mDegree;
+    size_t n = mPoints.size() - 1;
+    size_t m = n + p + 1;
+    const std::vector<T> &U = mKnots;
+    bool rational = isRational();
+
+    // Clamped: the first and the last knot both repeated degree + 1 times
+    for (size_t i = 1; i <= p; i++) {
+        assert(U[i] == U[0]);
+        assert(U[m - i] == U[m]);
+    }
+
+    BezierSegmentsT<T> segments;
+    segments.degree = p;
+
+    // Homogeneous points, segment s at Q[s * (p + 1)]
+    size_t maxSegments = n - p + 1;
+    std::vector<Vec3T<T> > Q(maxSegments * (p + 1));
+    std::vector<T> W(rational ? Q.size() : 0);
+    std::vector<T> alphas(p + 1);
+
+    for (size_t i = 0; i <= p; i++) {
+        Q[i] = rational ? mWeights[i] * mPoints[i] : mPoints[i];
+        if (rational) {
+            W[i] = mWeights[i];
+        }
+    }
+
+    segments.knots.push_back(U[p]);
+
+    size_t nb = 0;
+    size_t a = p;
+    size_t b = p + 1;
+
+    while (b < m) {
+        size_t i = b;
+
+        while (b < m && U[b + 1] == U[b]) {
+            b++;
+        }
+
+        size_t multiplicity = b - i + 1;
+        Vec3T<T> *current = Q.data() + nb * (p + 1);
+        T *currentWeights = rational ? W.data() + nb * (p + 1) : nullptr;
+
+        if (multiplicity < p) {
+            T numerator = U[b] - U[a];
+
+            for (size_t j = p; j > multiplicity; j--) {
+                alphas[j - multiplicity - 1] = numerator / (U[a + j] - U[a]);
+            }
+
+            size_t r = p - multiplicity;
+
+            // Inserts U[b] r times, the points pushed out start the next segment
+            for (size_t j = 1; j <= r; j++) {
+                size_t save = r - j;
+                size_t s = multiplicity + j;
+
+                for (size_t k = p; k >= s; k--) {
+                    T alpha = alphas[k - s];
+
+                    current[k] = alpha * current[k] + (1 - alpha) * current[k - 1];
+                    if (rational) {
+                        currentWeights[k] = alpha * currentWeights[k] + (1 - alpha) * currentWeights[k - 1];
+                    }
+                }
+
+                if (b < m) {
+                    Q[(nb + 1) * (p + 1) + save] = current[p];
+                    if (rational) {
+                        W[(nb + 1) * (p + 1) + save] = currentWeights[p];
+                    }
+                }
+            }
+        }
+
+        nb++;
+        segments.knots.push_back(U[b]);
+
+        if (b < m) {
+            for (size_t j = p - std::min(multiplicity, p); j <= p; j++) {
+                Q[nb * (p + 1) + j] = rational ? mWeights[b - p + j] * mPoints[b - p + j] : mPoints[b - p + j];
+                if (rational) {
+                    W[nb * (p + 1) + j] = mWeights[b - p + j];
+                }
+            }
+
+            a = b;
+            b++;
+        }
+    }
+
+    Q.resize(nb * (p + 1));
+
+    if (rational) {
+        W.resize(Q.size());
+
+        for (size_t i = 0; i < Q.size(); i++) {
+            Q[i] /= W[i];
+        }
+
+        segments.weights.swap(W);
+    }
+
+    segments.points.swap(Q);
+
+    return segments;
+}
+
+// Bezier curve of count points, rational when weights is not null, at us[0] to us[nbU - 1],
+// written to x, y, z. Scalar de Casteljau for the precisions the batch kernels do not cover.
+template<typename T, typename Lane>
+static void spanCurve(const Vec3T<T> *points, const T *weights, size_t count, const T *us, size_t nbU,
+                      Lane *x, Lane *y, Lane *z) {
+    std::vector<Vec3T<T> > scratch(count);
+    std::vector<T> scratchWeights(weights ? count : 0);
+
+    for (size_t i = 0; i < nbU; i++) {
+        T u = us[i];
+
+        for (size_t j = 0; j < count; j++) {
+            scratch[j] = weights ? weights[j] * points[j] : points[j];
+        }
+
+        Vec3T<T> point = CasteljauReduce(scratch.data(), count, u);
+
+        if (weights) {
+            std::copy(weights, weights + count, scratchWeights.begin());
+
+            for (size_t level = count; level > 1; level--) {
+                for (size_t j = 0; j + 1 < level; j++) {
+                    scratchWeights[j] += (scratchWeights[j + 1] - scratchWeights[j]) * u;
+                }
+            }
+
+            point /= scratchWeights[0];
+        }
+
+        x[i] = (Lane) point[0];
+        y[i] = (Lane) point[1];
+        z[i] = (Lane) point[2];
+    }
+}
+
+// Float spans go through the batch kernels of the active instruction set
+static void spanCurve(const Vec3 *points, const float *weights, size_t count, const float *us, size_t nbU,
+                      float *x, float *y, float *z) {
+    if (weights) {
+        RationalBezierCurveSoA(points, weights, count, us, nbU, x, y, z);
+    } else {
+        BezierCurveSoA(points, count, us, nbU, x, y, z);
+    }
+}
+
+template<typename T>
+std::vector<Vec3T<T> > BSplineT<T>::curve(long nbU) const {
+    BezierSegmentsT<T> segments = bezierSegments();
+    size_t count = segments.degree + 1;
+    size_t nbSamples = nbU > 0 ? (size_t) nbU : 0;
+
+    std::vector<Vec3T<T> > curvePoints;
+    curvePoints.reserve(segments.size() * nbSamples + 1);
+
+    // us, then the x, y and z lanes of one span
+    std::vector<T> buffer(4 * nbSamples);
+    T *us = buffer.data();
+    T *x = us + nbSamples;
+    T *y = x + nbSamples;
+    T *z = y + nbSamples;
+
+    for (size_t i = 0; i < nbSamples; i++) {
+        us[i] = (T) i / (T) nbU;
+    }
+
+    for (size_t s = 0; s < segments.size(); s++) {
+        const T *weights = isRational() ? segments.weights.data() + s * count : nullptr;
+
+        spanCurve(segments.points.data() + s * count, weights, count, us, nbSamples, x, y, z);
+
+        for (size_t i = 0; i < nbSamples; i++) {
+            curvePoints.push_back(Vec3T<T>(x[i], y[i], z[i]));
+        }
+    }
+
+    if (!segments.points.empty()) {
+        curvePoints.push_back(segments.points.back());
+    }
+
+    return curvePoints;
+}
+
+template<typename T>
+void BSplineT<T>::curve(long nbU, Vec3Array &out) const {
+    BezierSegmentsT<T> segments = bezierSegments();
+    size_t count = segments.degree + 1;
+    size_t nbSamples = nbU > 0 ? (size_t) nbU : 0;
+
+    out.resize(segments.points.empty() ? 0 : segments.size() * nbSamples + 1);
+
+    std::vector<T> us(nbSamples);
+
+    for (size_t i = 0; i < nbSamples; i++) {
+        us[i] = (T) i / (T) nbU;
+    }
+
+    for (size_t s = 0; s < segments.size(); s++) {
+        const T *weights = isRational() ? segments.weights.data() + s * count : nullptr;
+        size_t first = s * nbSamples;
+
+        spanCurve(segments.points.data() + s * count, weights, count, us.data(), nbSamples,
+                  out.x() + first, out.y() + first, out.z() + first);
+    }
+
+    if (!segments.points.empty()) {
+        out.set(out.size() - 1, Vec3(segments.points.back()));
+    }
+}
+
+#define INSTANTIATE_BSPLINE(T) \
+    template std::vector<T> ClampedUniformKnots<T>(size_t, size_t); \
+    template class BSplineT<T>;
+
+INSTANTIATE_BSPLINE(float)
+INSTANTIATE_BSPLINE(double)
+INSTANTIATE_BSPLINE(long double)
@@ -0,0 +1,97 @@
+//
+// B-spline and NURBS curves: de Boor evaluation, Boehm knot insertion, Bezier extraction.
+//
+
+#ifndef MODELISATION_TP1_BSPLINE_H
+#define MODELISATION_TP1_BSPLINE_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "../Simd/vec3Array.h"
+
+// Everything here is instantiated for float, double and long double in bspline.cpp.
+
+// Degrees up to this one are evaluated in stack buffers.
+static const size_t BSPLINE_STACK_DEGREE = 15;
+
+// nbPoints + degree + 1 knots: degree + 1 zeros, uniform interior knots, degree + 1 ones,
+// so that the curve starts on the first control point and ends on the last one.
+template<typename T>
+std::vector<T> ClampedUniformKnots(size_t nbPoints, size_t degree);
+
+// Bezier segments of a spline, each of degree + 1 points, back to back. Segment s covers
+// [knots[s], knots[s + 1]] of the spline. weights is empty for a non rational spline, otherwise
+// the segments are rational with weights[i] the weight of points[i].
+template<typename T>
+struct BezierSegmentsT {
+    size_t degree;
+    std::vector<Vec3T<T> > points;
+    std::vector<T> weights;
+    std::vector<T> knots;
+
+    size_t size() const { return knots.empty() ? 0 : knots.size() - 1; }
+};
+
+typedef BezierSegmentsT<float> BezierSegments;
+
+// Moving a control point only changes the curve over the degree + 1 spans it supports,
+// and the degree does not grow with the number of points.
+// A NURBS when weights are given: points are then evaluated in homogeneous coordinates.
+template<typename T>
+class BSplineT {
+public:
+    // knots holds controlPoints.size() + degree + 1 non decreasing values.
+    BSplineT(size_t degree, const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &knots);
+
+    BSplineT(size_t degree, const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &knots,
+             const std::vector<T> &weights);
+
+    size_t degree() const { return mDegree; }
+
+    const std::vector<Vec3T<T> > &controlPoints() const { return mPoints; }
+
+    const std::vector<T> &knots() const { return mKnots; }
+
+    const std::vector<T> &weights() const { return mWeights; }
+
+    bool isRational() const { return !mWeights.empty(); }
+
+    // Parameter domain [knots[degree], knots[nbPoints]].
+    T start() const { return mKnots[mDegree]; }
+
+    T end() const { return mKnots[mPoints.size()]; }
+
+    // k in [degree, nbPoints - 1] with knots[k] <= t < knots[k + 1], by binary search.
+    // The end of the domain belongs to the last span.
+    size_t findSpan(T t) const;
+
+    // de Boor: degree levels of affine combinations over the degree + 1 points acting on t's span.
+    Vec3T<T> point(T t) const;
+
+    // Boehm: inserts t once in the knot vector, the curve is unchanged, one more control point.
+    void insertKnot(T t);
+
+    // Every span as a Bezier curve, by raising each interior knot to multiplicity degree, in one
+    // pass over the control points (Piegl and Tiller, DecomposeCurve). Needs a clamped knot vector,
+    // asserted: the first and last knots repeated degree + 1 times.
+    BezierSegmentsT<T> bezierSegments() const;
+
+    // nbU points per non empty span at uniform steps of its Bezier segment, spans back to back,
+    // then the end point. Each segment is read in place: in float through the batch kernels of
+    // Simd/, in double and long double by scalar de Casteljau.
+    std::vector<Vec3T<T> > curve(long nbU) const;
+
+    // The same points written straight into out's float lanes, resized to hold them.
+    void curve(long nbU, Vec3Array &out) const;
+
+private:
+    size_t mDegree;
+    std::vector<Vec3T<T> > mPoints;
+    std::vector<T> mKnots;
+    std::vector<T> mWeights;
+};
+
+typedef BSplineT<float> BSpline;
+
+#endif //MODELISATION_TP1_BSPLINE_H
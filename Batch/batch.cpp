@@ -0,0 +1,145 @@
+//
+// Tessellation of many curves at once, spread over a ThreadPool, into one flat buffer.
+//
+
+#include "batch.h"
+#include "../Casteljau/casteljau.h"
+#include "../Berstein/berstein.h"
+#include "../Hermite/hermite.h"
+
+#include <algorithm>
+
+// Curve samples go to an interleaved buffer or to the lanes of a Vec3Array
+static void store(Vec3 *out, long i, const Vec3 &p) {
+    out[i] = p;
+}
+
+static void store(const Vec3ArrayView &out, long i, const Vec3 &p) {
+    out.x[i] = p[0];
+    out.y[i] = p[1];
+    out.z[i] = p[2];
+}
+
+static Vec3 *shifted(Vec3 *out, size_t n) {
+    return out + n;
+}
+
+static Vec3ArrayView shifted(const Vec3ArrayView &out, size_t n) {
+    Vec3ArrayView lanes = {out.x + n, out.y + n, out.z + n, out.size - n};
+    return lanes;
+}
+
+template<typename Out>
+static void tessellateByCasteljau(const Vec3 *controlPoints, size_t nbPoints, long nbU, const Out &out,
+                                  CasteljauWorkspace &workspace) {
+    Vec3 *points = workspace.acquire(nbPoints);
+
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+
+        std::copy(controlPoints, controlPoints + nbPoints, points);
+        store(out, i, CasteljauReduce(points, nbPoints, u));
+    }
+}
+
+template<typename Out>
+static void tessellateByBernstein(const Vec3 *controlPoints, size_t nbPoints, long nbU, const Out &out,
+                                  std::vector<double> &basis) {
+    basis.resize(nbPoints);
+
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+
+        BernsteinBasis(nbPoints - 1, u, basis.data());
+        store(out, i, BezierPointFromBasis(controlPoints, nbPoints, basis.data()));
+    }
+}
+
+template<typename Out>
+static void tessellateByHermite(const Vec3 *controlPoints, long nbU, const Out &out) {
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+
+        store(out, i, HermiteCubicPoint(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3], u));
+    }
+}
+
+// nbU > 0 samples of every curve, curve c's at shifted(points, c * nbU)
+template<typename Out>
+static void tessellate(const CurveBatch &curves, CurveEngine engine, long nbU, ThreadPool &pool, const Out &points) {
+    RangeTask task = [&](size_t begin, size_t end) {
+        CasteljauWorkspace workspace;
+        std::vector<double> basis;
+
+        for (size_t c = begin; c < end; c++) {
+            const Vec3 *controlPoints = curves.points.data() + curves.offsets[c];
+            size_t nbPoints = curves.offsets[c + 1] - curves.offsets[c];
+            Out out = shifted(points, c * nbU);
+
+            // Checked in every build: a Hermite entry of the wrong size would be read past its end
+            if (nbPoints == 0 || (engine == ENGINE_HERMITE && nbPoints != 4)) {
+                for (long i = 0; i < nbU; i++) {
+                    store(out, i, Vec3(0, 0, 0));
+                }
+                continue;
+            }
+
+            switch (engine) {
+                case ENGINE_CASTELJAU:
+                    tessellateByCasteljau(controlPoints, nbPoints, nbU, out, workspace);
+                    break;
+                case ENGINE_BERNSTEIN:
+                    tessellateByBernstein(controlPoints, nbPoints, nbU, out, basis);
+                    break;
+                case ENGINE_HERMITE:
+                    tessellateByHermite(controlPoints, nbU, out);
+                    break;
+            }
+        }
+    };
+
+    pool.parallelFor(curves.size(), BATCH_GRAIN, task);
+}
+
+static std::vector<size_t> uniformOffsets(size_t nbCurves, long nbU) {
+    std::vector<size_t> offsets(nbCurves + 1);
+
+    for (size_t c = 0; c <= nbCurves; c++) {
+        offsets[c] = nbU > 0 ? c * nbU : 0;
+    }
+
+    return offsets;
+}
+
+TessellatedBatch TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU, ThreadPool &pool) {
+    TessellatedBatch result;
+    result.offsets = uniformOffsets(curves.size(), nbU);
+
+    if (nbU <= 0) {
+        return result;
+    }
+
+    result.points.resize(curves.size() * nbU);
+    tessellate(curves, engine, nbU, pool, result.points.data());
+
+    return result;
+}
+
+TessellatedBatch TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU) {
+    return TessellateBatch(curves, engine, nbU, DefaultThreadPool());
+}
+
+void TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU, ThreadPool &pool,
+                     Vec3Array &points, std::vector<size_t> &offsets) {
+    offsets = uniformOffsets(curves.size(), nbU);
+    points.resize(offsets.back());
+
+    if (nbU > 0) {
+        tessellate(curves, engine, nbU, pool, points.view());
+    }
+}
+
+void TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU, Vec3Array &points,
+                     std::vector<size_t> &offsets) {
+    TessellateBatch(curves, engine, nbU, DefaultThreadPool(), points, offsets);
+}
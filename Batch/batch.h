@@ -0,0 +1,59 @@
+//
+// Tessellation of many curves at once, spread over a ThreadPool, into one flat buffer.
+//
+
+#ifndef MODELISATION_TP1_BATCH_H
+#define MODELISATION_TP1_BATCH_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "threadPool.h"
+#include "../Simd/vec3Array.h"
+
+enum CurveEngine {
+    ENGINE_CASTELJAU,
+    ENGINE_BERNSTEIN,
+    ENGINE_HERMITE
+};
+
+// Control polygons stored back to back. Curve c uses points[offsets[c]] to points[offsets[c + 1] - 1].
+// Hermite curves are stored as p0, p1, v0, v1.
+struct CurveBatch {
+    std::vector<Vec3> points;
+    std::vector<size_t> offsets;
+
+    CurveBatch() : offsets(1, 0) {}
+
+    void addCurve(const std::vector<Vec3> &controlPoints) {
+        points.insert(points.end(), controlPoints.begin(), controlPoints.end());
+        offsets.push_back(points.size());
+    }
+
+    size_t size() const { return offsets.size() - 1; }
+};
+
+// Curve c's samples are points[offsets[c]] to points[offsets[c + 1] - 1], in input order
+// whatever the number of threads. Empty curves, and Hermite entries that do not hold exactly
+// 4 points, get nbU samples at the origin. nbU <= 0 gives no samples at all.
+struct TessellatedBatch {
+    std::vector<Vec3> points;
+    std::vector<size_t> offsets;
+};
+
+// Curves per task handed to the pool.
+static const size_t BATCH_GRAIN = 64;
+
+extern TessellatedBatch TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU, ThreadPool &pool);
+
+extern TessellatedBatch TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU);
+
+// The same samples written straight into the lanes of points, resized to hold them, with offsets
+// as in TessellatedBatch.
+extern void TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU, ThreadPool &pool,
+                            Vec3Array &points, std::vector<size_t> &offsets);
+
+extern void TessellateBatch(const CurveBatch &curves, CurveEngine engine, long nbU, Vec3Array &points,
+                            std::vector<size_t> &offsets);
+
+#endif //MODELISATION_TP1_BATCH_H
@@ -0,0 +1,129 @@
+//
+// Fixed set of worker threads running index ranges, with work stealing between workers.
+//
+
+#include "threadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int nbThreads) : mGeneration(0), mStop(false), mRemaining(0) {
+    if (nbThreads == 0) {
+        nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned int i = 0; i < nbThreads; i++) {
+        mWorkers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+
+    for (unsigned int i = 0; i < nbThreads; i++) {
+        mWorkers[i]->thread = std::thread(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for (std::unique_ptr<Worker> &worker : mWorkers) {
+        worker->thread.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeTask &task) {
+    if (count == 0) {
+        return;
+    }
+
+    grain = std::max<size_t>(1, grain);
+
+    if (mWorkers.size() == 1 || count <= grain) {
+        task(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(mSubmitMutex);
+
+    // Set before any chunk is visible, a worker still draining may pick one up right away
+    mRemaining = count;
+
+    size_t nbChunks = (count + grain - 1) / grain;
+
+    for (size_t c = 0; c < nbChunks; c++) {
+        Chunk chunk = {&task, c * grain, std::min(count, (c + 1) * grain)};
+        Worker &worker = *mWorkers[c % mWorkers.size()];
+
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.chunks.push_back(chunk);
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mGeneration++;
+    mWake.notify_all();
+
+    mDone.wait(lock, [this] { return mRemaining == 0; });
+}
+
+bool ThreadPool::popOrSteal(unsigned int id, Chunk &chunk) {
+    {
+        Worker &own = *mWorkers[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+
+    for (size_t k = 1; k < mWorkers.size(); k++) {
+        Worker &victim = *mWorkers[(id + k) % mWorkers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(unsigned int id) {
+    unsigned long seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [&] { return mStop || mGeneration != seenGeneration; });
+
+            if (mStop) {
+                return;
+            }
+
+            seenGeneration = mGeneration;
+        }
+
+        Chunk chunk;
+
+        // Chunks carry their own task, a late worker can never run a stale one
+        while (popOrSteal(id, chunk)) {
+            (*chunk.task)(chunk.begin, chunk.end);
+
+            size_t done = chunk.end - chunk.begin;
+
+            if (mRemaining.fetch_sub(done) == done) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mDone.notify_all();
+            }
+        }
+    }
+}
+
+ThreadPool &DefaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,73 @@
+//
+// Fixed set of worker threads running index ranges, with work stealing between workers.
+//
+
+#ifndef MODELISATION_TP1_THREADPOOL_H
+#define MODELISATION_TP1_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Called with a half-open range [begin, end) of item indices.
+typedef std::function<void(size_t begin, size_t end)> RangeTask;
+
+class ThreadPool {
+public:
+    // 0 picks std::thread::hardware_concurrency().
+    explicit ThreadPool(unsigned int nbThreads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned int size() const { return (unsigned int) mWorkers.size(); }
+
+    // Splits [0, count) into chunks of at most grain items, deals them round robin to the
+    // workers and blocks until every chunk ran. A worker that runs out of chunks steals
+    // from the front of another worker's queue while the owner pops from the back.
+    void parallelFor(size_t count, size_t grain, const RangeTask &task);
+
+private:
+    struct Chunk {
+        const RangeTask *task;
+        size_t begin;
+        size_t end;
+    };
+
+    struct Worker {
+        std::deque<Chunk> chunks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    void run(unsigned int id);
+
+    bool popOrSteal(unsigned int id, Chunk &chunk);
+
+    std::vector<std::unique_ptr<Worker> > mWorkers;
+
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    unsigned long mGeneration;
+    bool mStop;
+
+    std::atomic<size_t> mRemaining;
+
+    // Serializes concurrent parallelFor calls on the same pool
+    std::mutex mSubmitMutex;
+};
+
+// Shared pool sized to the machine, created on first use.
+extern ThreadPool &DefaultThreadPool();
+
+#endif //MODELISATION_TP1_THREADPOOL_H
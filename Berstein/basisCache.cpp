@@ -0,0 +1,131 @@
+//
+// Bernstein basis tables shared by every curve of the same degree and resolution.
+//
+
+#include "basisCache.h"
+#include "berstein.h"
+
+#include <gsl/gsl_cblas.h>
+
+// The product reads the control points as a (n+1) x 3 row-major float matrix
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 must be three packed floats");
+
+
+static std::shared_ptr<const BasisMatrix> buildBasisMatrix(unsigned long degree, long nbU) {
+    std::shared_ptr<BasisMatrix> matrix = std::make_shared<BasisMatrix>(nbU * (degree + 1));
+    std::vector<double> basis(degree + 1);
+
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+
+        BernsteinBasis(degree, u, basis.data());
+
+        for (unsigned long j = 0; j <= degree; j++) {
+            (*matrix)[i * (degree + 1) + j] = basis[j];
+        }
+    }
+
+    return matrix;
+}
+
+
+BernsteinBasisCache::BernsteinBasisCache(size_t memoryBudget)
+        : mMemoryBudget(memoryBudget), mMemoryUsed(0), mClock(0), mHits(0), mMisses(0) {
+}
+
+
+std::shared_ptr<const BasisMatrix> BernsteinBasisCache::basisMatrix(unsigned long degree, long nbU) {
+    Key key(degree, nbU);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClock++;
+
+        std::map<Key, Entry>::iterator found = mTables.find(key);
+        if (found != mTables.end()) {
+            mHits++;
+            found->second.lastUse = mClock;
+            return found->second.matrix;
+        }
+
+        mMisses++;
+    }
+
+    // Built outside the lock, so that a large miss does not hold up lookups of other tables
+    std::shared_ptr<const BasisMatrix> matrix = buildBasisMatrix(degree, nbU);
+    size_t bytes = matrix->size() * sizeof(float);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Another thread may have built the same table meanwhile, keep the stored one
+    std::map<Key, Entry>::iterator found = mTables.find(key);
+    if (found != mTables.end()) {
+        found->second.lastUse = ++mClock;
+        return found->second.matrix;
+    }
+
+    if (bytes <= mMemoryBudget) {
+        evictUntilFits(bytes);
+
+        Entry entry;
+        entry.matrix = matrix;
+        entry.lastUse = ++mClock;
+
+        mTables[key] = entry;
+        mMemoryUsed += bytes;
+    }
+
+    return matrix;
+}
+
+
+std::vector<Vec3> BernsteinBasisCache::tessellate(const std::vector<Vec3> &controlPoints, long nbU) {
+    if (controlPoints.empty() || nbU <= 0) {
+        return std::vector<Vec3>();
+    }
+
+    std::vector<Vec3> curvePoints(nbU);
+
+    int nbPoints = (int) controlPoints.size();
+    std::shared_ptr<const BasisMatrix> matrix = basisMatrix(nbPoints - 1, nbU);
+
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                (int) nbU, 3, nbPoints,
+                1.0f, matrix->data(), nbPoints,
+                reinterpret_cast<const float *>(controlPoints.data()), 3,
+                0.0f, reinterpret_cast<float *>(curvePoints.data()), 3);
+
+    return curvePoints;
+}
+
+
+void BernsteinBasisCache::clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mTables.clear();
+    mMemoryUsed = 0;
+    mHits = 0;
+    mMisses = 0;
+}
+
+
+void BernsteinBasisCache::evictUntilFits(size_t bytes) {
+    // Least recently used first
+    while (!mTables.empty() && mMemoryUsed + bytes > mMemoryBudget) {
+        std::map<Key, Entry>::iterator oldest = mTables.begin();
+
+        for (std::map<Key, Entry>::iterator it = mTables.begin(); it != mTables.end(); ++it) {
+            if (it->second.lastUse < oldest->second.lastUse) {
+                oldest = it;
+            }
+        }
+
+        mMemoryUsed -= oldest->second.matrix->size() * sizeof(float);
+        mTables.erase(oldest);
+    }
+}
+
+
+std::vector<Vec3> BezierCurveByBernstein(const std::vector<Vec3> &controlPoints, long nbU, BernsteinBasisCache &cache) {
+    return cache.tessellate(controlPoints, nbU);
+}
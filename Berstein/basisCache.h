@@ -0,0 +1,70 @@
+//
+// Bernstein basis tables shared by every curve of the same degree and resolution.
+//
+
+#ifndef MODELISATION_TP1_BASISCACHE_H
+#define MODELISATION_TP1_BASISCACHE_H
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "../src/Vec3.h"
+
+// Row-major nbU x (degree + 1) matrix, row i holding B_0..B_degree at u = i / nbU.
+typedef std::vector<float> BasisMatrix;
+
+class BernsteinBasisCache {
+public:
+    explicit BernsteinBasisCache(size_t memoryBudget = 64 * 1024 * 1024);
+
+    // Tables bigger than the whole budget are built but never stored. Misses build outside the
+    // lock, two threads missing the same table may both build it, the first one stored is kept.
+    std::shared_ptr<const BasisMatrix> basisMatrix(unsigned long degree, long nbU);
+
+    // Same points as BezierCurveByBernstein, as one (nbU x n+1) . (n+1 x 3) product.
+    std::vector<Vec3> tessellate(const std::vector<Vec3> &controlPoints, long nbU);
+
+    void clear();
+
+    // Counters are updated under mMutex by concurrent lookups, so they are read under it too
+    unsigned long hits() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mHits;
+    }
+
+    unsigned long misses() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMisses;
+    }
+
+    size_t memoryUsed() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMemoryUsed;
+    }
+
+    size_t memoryBudget() const { return mMemoryBudget; }
+
+private:
+    typedef std::pair<unsigned long, long> Key;
+
+    struct Entry {
+        std::shared_ptr<const BasisMatrix> matrix;
+        unsigned long lastUse;
+    };
+
+    void evictUntilFits(size_t bytes);
+
+    std::map<Key, Entry> mTables;
+    mutable std::mutex mMutex;
+    size_t mMemoryBudget;
+    size_t mMemoryUsed;
+    unsigned long mClock;
+    unsigned long mHits;
+    unsigned long mMisses;
+};
+
+extern std::vector<Vec3> BezierCurveByBernstein(const std::vector<Vec3> &controlPoints, long nbU, BernsteinBasisCache &cache);
+
+#endif //MODELISATION_TP1_BASISCACHE_H
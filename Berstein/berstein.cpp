@@ -5,15 +5,43 @@
 #include "berstein.h"
 
 
-std::vector<Vec3> BezierCurveByBernstein(const std::vector<Vec3> &controlPoints, long nbU) {
-    std::vector<Vec3> curvePoints;
+// Summed directly rather than through lgamma, which writes the global signgam and is not thread safe
+template<typename B>
+static B logBinomial(unsigned long n, unsigned long k) {
+    if (k > n - k) {
+        k = n - k;
+    }
+
+    B result = 0;
+
+    for (unsigned long j = 1; j <= k; j++) {
+        result += std::log((B) (n - k + j) / (B) j);
+    }
+
+    return result;
+}
+
+
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveByBernstein(const std::vector<Vec3T<T> > &controlPoints, long nbU) {
+    typedef typename WideScalar<T>::type W;
+
+    std::vector<Vec3T<T> > curvePoints;
     curvePoints.reserve(nbU);
 
+    if (controlPoints.empty()) {
+        return curvePoints;
+    }
+
+    std::vector<W> basis(controlPoints.size());
+
     for (int i = 0; i < nbU; i++) {
-        float u = (float) i / (float) nbU;
+        T u = (T) i / (T) nbU;
+
+        BernsteinBasis(controlPoints.size() - 1, u, basis.data());
 
         curvePoints.push_back(
-                BezierPointByBernstein(controlPoints, u)
+                BezierPointFromBasis(controlPoints, basis.data())
         );
     }
 
@@ -21,29 +49,229 @@ std::vector<Vec3> BezierCurveByBernstein(const std::vector<Vec3> &controlPoints,
 }
 
 
-Vec3 BezierPointByBernstein(const std::vector<Vec3> &controlPoints, float u) {
-    Vec3 point = Vec3(0, 0, 0);
+void BezierCurveByBernstein(const std::vector<Vec3> &controlPoints, const long nbU, Vec3Array &out) {
+    if (controlPoints.empty()) {
+        out.resize(0);
+        return;
+    }
+
+    out.resize(nbU > 0 ? nbU : 0);
+
+    std::vector<double> basis(controlPoints.size());
 
-    for (int i = 0; i < controlPoints.size(); i++) {
-        float B = BernsteinPoly(controlPoints.size() - 1, i, u);
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
 
-        Vec3 addedPoint = controlPoints[i];
-        addedPoint *= B;
+        BernsteinBasis(controlPoints.size() - 1, u, basis.data());
 
-        point += addedPoint;
+        out.set(i, BezierPointFromBasis(controlPoints, basis.data()));
     }
+}
+
+
+template<typename T>
+CurveDifferentialsT<T> BezierDifferentialsByBernstein(const std::vector<Vec3T<T> > &controlPoints, long nbU) {
+    typedef typename WideScalar<T>::type W;
+
+    CurveDifferentialsT<T> differentials;
+    differentials.resize(nbU);
+
+    size_t nbPoints = controlPoints.size();
+    long n = (long) nbPoints - 1;
+
+    if (n < 2) {
+        // Constant or straight line, nothing to get from the hodographs
+        for (long i = 0; i < nbU; i++) {
+            T u = (T) i / (T) nbU;
 
-    return point;
+            differentials.positions[i] = BezierPointByBernstein(controlPoints, u);
+            differentials.firstDerivatives[i] = n == 1 ? controlPoints[1] - controlPoints[0] : Vec3T<T>(0, 0, 0);
+            differentials.secondDerivatives[i] = Vec3T<T>(0, 0, 0);
+            differentials.curvatures[i] = 0;
+        }
+
+        return differentials;
+    }
+
+    // basis2, basis1, basis0 hold the bases of degree n - 2, n - 1 and n
+    std::vector<W> bases(3 * nbPoints);
+    W *basis2 = bases.data();
+    W *basis1 = basis2 + nbPoints;
+    W *basis0 = basis1 + nbPoints;
+
+    for (long i = 0; i < nbU; i++) {
+        W u = (T) i / (T) nbU;
+
+        BernsteinBasis(n - 2, u, basis2);
+
+        // Degree elevation of the basis values: B_k^(m+1) = (1 - u) B_k^m + u B_(k-1)^m
+        for (long k = 0; k <= n - 1; k++) {
+            basis1[k] = (k <= n - 2 ? (1 - u) * basis2[k] : 0) + (k > 0 ? u * basis2[k - 1] : 0);
+        }
+
+        for (long k = 0; k <= n; k++) {
+            basis0[k] = (k <= n - 1 ? (1 - u) * basis1[k] : 0) + (k > 0 ? u * basis1[k - 1] : 0);
+        }
+
+        W position[3] = {0, 0, 0};
+        W first[3] = {0, 0, 0};
+        W second[3] = {0, 0, 0};
+
+        for (long k = 0; k <= n; k++) {
+            for (int j = 0; j < 3; j++) {
+                W p0 = controlPoints[k][j];
+
+                position[j] += basis0[k] * p0;
+
+                if (k < n) {
+                    W p1 = controlPoints[k + 1][j];
+                    first[j] += basis1[k] * (p1 - p0);
+
+                    if (k < n - 1) {
+                        W p2 = controlPoints[k + 2][j];
+                        second[j] += basis2[k] * (p2 - 2 * p1 + p0);
+                    }
+                }
+            }
+        }
+
+        W n1 = (W) n;
+        W n2 = (W) (n * (n - 1));
+
+        differentials.positions[i] = Vec3T<T>(position[0], position[1], position[2]);
+        differentials.firstDerivatives[i] = Vec3T<T>(n1 * first[0], n1 * first[1], n1 * first[2]);
+        differentials.secondDerivatives[i] = Vec3T<T>(n2 * second[0], n2 * second[1], n2 * second[2]);
+        differentials.curvatures[i] = Curvature(differentials.firstDerivatives[i], differentials.secondDerivatives[i]);
+    }
+
+    return differentials;
 }
 
 
-float BernsteinPoly(unsigned long n, unsigned long i, float u) {
-    return binomial(n, i) * pow(u, i) * pow(1 - u, n - i);
+template<typename T>
+Vec3T<T> BezierPointByBernstein(const std::vector<Vec3T<T> > &controlPoints, typename NonDeduced<T>::type u) {
+    typedef typename WideScalar<T>::type W;
+
+    if (controlPoints.empty()) {
+        return Vec3T<T>(0, 0, 0);
+    }
+
+    W stackBasis[BERNSTEIN_STACK_POINTS];
+    std::vector<W> heapBasis;
+    W *basis = stackBasis;
+
+    if (controlPoints.size() > BERNSTEIN_STACK_POINTS) {
+        heapBasis.resize(controlPoints.size());
+        basis = heapBasis.data();
+    }
+
+    BernsteinBasis(controlPoints.size() - 1, u, basis);
+
+    return BezierPointFromBasis(controlPoints, basis);
+}
+
+
+template<typename T>
+Vec3T<T> BezierPointFromBasis(const std::vector<Vec3T<T> > &controlPoints,
+                              const typename WideScalar<T>::type *basis) {
+    return BezierPointFromBasis(controlPoints.data(), controlPoints.size(), basis);
+}
+
+
+template<typename T>
+Vec3T<T> BezierPointFromBasis(const Vec3T<T> *controlPoints, size_t nbPoints,
+                              const typename WideScalar<T>::type *basis) {
+    typedef typename WideScalar<T>::type W;
+
+    // One accumulator per coordinate: no Vec3 built per term, even in unoptimized builds
+    W x = 0;
+    W y = 0;
+    W z = 0;
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        W b = basis[i];
+
+        x += b * controlPoints[i][0];
+        y += b * controlPoints[i][1];
+        z += b * controlPoints[i][2];
+    }
+
+    return Vec3T<T>(x, y, z);
+}
+
+
+template<typename B>
+void BernsteinBasis(unsigned long n, typename NonDeduced<B>::type u, B *basis) {
+    for (unsigned long i = 0; i <= n; i++) {
+        basis[i] = 0;
+    }
+
+    if (u <= 0) {
+        basis[0] = 1;
+        return;
+    }
+
+    if (u >= 1) {
+        basis[n] = 1;
+        return;
+    }
+
+    unsigned long m = (unsigned long) (u * n);
+    if (m > n) {
+        m = n;
+    }
+
+    B ratio = u / (1 - u);
+
+    basis[m] = std::exp(logBinomial<B>(n, m) + m * std::log(u) + (n - m) * std::log1p(-u));
+
+    for (unsigned long i = m; i < n; i++) {
+        basis[i + 1] = basis[i] * ((B) (n - i) / (B) (i + 1)) * ratio;
+    }
+
+    for (unsigned long i = m; i > 0; i--) {
+        basis[i - 1] = basis[i] * ((B) i / (B) (n - i + 1)) / ratio;
+    }
+}
+
+
+template<typename T>
+T BernsteinPoly(unsigned long n, unsigned long i, T u) {
+    typedef typename WideScalar<T>::type W;
+
+    if (i > n) {
+        return 0;
+    }
+
+    if (u <= 0) {
+        return i == 0 ? 1 : 0;
+    }
+
+    if (u >= 1) {
+        return i == n ? 1 : 0;
+    }
+
+    return std::exp(logBinomial<W>(n, i) + i * std::log((W) u) + (n - i) * std::log1p(-(W) u));
 }
 
 
 unsigned long binomial(unsigned long n, unsigned long k) {
-    return factorial(n) / (factorial(k) * factorial(n - k));
+    if (k > n) {
+        return 0;
+    }
+
+    if (k > n - k) {
+        k = n - k;
+    }
+
+    // C(n - k + j, j) stays an integer at every step, no factorial needed
+    unsigned long result = 1;
+
+    for (unsigned long j = 1; j <= k; j++) {
+        result = result * (n - k + j) / j;
+    }
+
+    return result;
 }
 
 
@@ -57,3 +285,17 @@ unsigned long factorial(unsigned long n) {
 
     return result;
 }
+
+
+#define INSTANTIATE_BERNSTEIN(T) \
+    template std::vector<Vec3T<T> > BezierCurveByBernstein<T>(const std::vector<Vec3T<T> > &, long); \
+    template Vec3T<T> BezierPointByBernstein<T>(const std::vector<Vec3T<T> > &, T); \
+    template CurveDifferentialsT<T> BezierDifferentialsByBernstein<T>(const std::vector<Vec3T<T> > &, long); \
+    template Vec3T<T> BezierPointFromBasis<T>(const std::vector<Vec3T<T> > &, const WideScalar<T>::type *); \
+    template Vec3T<T> BezierPointFromBasis<T>(const Vec3T<T> *, size_t, const WideScalar<T>::type *); \
+    template void BernsteinBasis<T>(unsigned long, T, T *); \
+    template T BernsteinPoly<T>(unsigned long, unsigned long, T);
+
+INSTANTIATE_BERNSTEIN(float)
+INSTANTIATE_BERNSTEIN(double)
+INSTANTIATE_BERNSTEIN(long double)
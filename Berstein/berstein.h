@@ -8,15 +8,57 @@
 #include <vector>
 #include <cmath>
 #include "../src/Vec3.h"
+#include "../src/CurveDifferentials.h"
+#include "../Simd/vec3Array.h"
 
-extern std::vector<Vec3> BezierCurveByBernstein(const std::vector<Vec3> &controlPoints, long nbU);
+// Everything here is instantiated for float, double and long double in berstein.cpp.
 
-extern Vec3 BezierPointByBernstein(const std::vector<Vec3> &controlPoints, float u);
+// Curves up to this many control points get their basis values on the stack.
+static const size_t BERNSTEIN_STACK_POINTS = 32;
 
-extern float BernsteinPoly(unsigned long n, unsigned long i, float u);
+// Basis values and sums are kept in at least double: double for float curves, T otherwise.
+template<typename T>
+struct WideScalar {
+    typedef decltype(T() + 0.0) type;
+};
+
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveByBernstein(const std::vector<Vec3T<T> > &controlPoints, long nbU);
+
+// The same points in float, written straight into out's lanes, resized to nbU points, or to none
+// without control points.
+extern void BezierCurveByBernstein(const std::vector<Vec3> &controlPoints, long nbU, Vec3Array &out);
+
+template<typename T>
+Vec3T<T> BezierPointByBernstein(const std::vector<Vec3T<T> > &controlPoints, typename NonDeduced<T>::type u);
+
+// Position, derivatives and curvature at every u = i / nbU. The derivatives are the
+// hodographs n sum B_i^(n-1) (P_(i+1) - P_i) and n (n-1) sum B_i^(n-2) (P_(i+2) - 2 P_(i+1) + P_i),
+// all three bases coming from a single BernsteinBasis pass at degree n - 2.
+template<typename T>
+CurveDifferentialsT<T> BezierDifferentialsByBernstein(const std::vector<Vec3T<T> > &controlPoints, long nbU);
+
+// Weighted sum of the control points with precomputed basis values (controlPoints.size() of them).
+template<typename T>
+Vec3T<T> BezierPointFromBasis(const std::vector<Vec3T<T> > &controlPoints,
+                              const typename WideScalar<T>::type *basis);
+
+template<typename T>
+Vec3T<T> BezierPointFromBasis(const Vec3T<T> *controlPoints, size_t nbPoints,
+                              const typename WideScalar<T>::type *basis);
+
+// Fills basis[0..n] with every B_i^n(u) in a single O(n) pass.
+// Starts from the dominant term (computed in log space) and walks outwards with the ratio
+// B_(i+1) / B_i = (n - i) / (i + 1) * u / (1 - u), so nothing overflows whatever the degree.
+template<typename B>
+void BernsteinBasis(unsigned long n, typename NonDeduced<B>::type u, B *basis);
+
+template<typename T>
+T BernsteinPoly(unsigned long n, unsigned long i, T u);
 
 extern unsigned long binomial(unsigned long n, unsigned long k);
 
+// Overflows unsigned long past n = 20, only kept for small exact values.
 extern unsigned long factorial(unsigned long n);
 
 #endif //MODELISATION_TP1_BERSTEIN_H
@@ -0,0 +1,143 @@
+//
+// Bezier curves converted once to the power (monomial) basis.
+//
+
+#include "monomial.h"
+#include "../Casteljau/casteljau.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+MonomialCurve::MonomialCurve(const std::vector<Vec3> &controlPoints, double tolerance)
+        : mControlPoints(controlPoints), mConditionNumber(INFINITY), mUsesMonomialBasis(false) {
+    size_t nbPoints = controlPoints.size();
+
+    if (nbPoints == 0 || nbPoints > MONOMIAL_MAX_POINTS) {
+        return;
+    }
+
+    size_t n = nbPoints - 1;
+    mCoefficients.resize(3 * nbPoints);
+
+    // a_k = C(n, k) * (k-th forward difference of the control points at 0)
+    double differences[MONOMIAL_MAX_POINTS][3];
+    double size = 0;
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        for (int j = 0; j < 3; j++) {
+            differences[i][j] = controlPoints[i][j];
+            size = std::max(size, std::fabs(differences[i][j]));
+        }
+    }
+
+    double binomial = 1;
+    double differenceAmplification = 0;
+    double coefficientsSum[3] = {0, 0, 0};
+
+    for (size_t k = 0; k <= n; k++) {
+        for (int j = 0; j < 3; j++) {
+            mCoefficients[3 * k + j] = binomial * differences[0][j];
+            coefficientsSum[j] += std::fabs(mCoefficients[3 * k + j]);
+        }
+
+        // A k-th difference carries up to 2^k times the rounding error of the points
+        differenceAmplification += binomial * std::ldexp(1.0, (int) k);
+
+        for (size_t i = 0; i + k < n; i++) {
+            for (int j = 0; j < 3; j++) {
+                differences[i][j] = differences[i + 1][j] - differences[i][j];
+            }
+        }
+
+        binomial = binomial * (double) (n - k) / (double) (k + 1);
+    }
+
+    // Conversion errors, plus about 2n roundings of terms up to sum |a_k| during evaluation
+    double largestSum = std::max(coefficientsSum[0], std::max(coefficientsSum[1], coefficientsSum[2]));
+
+    mConditionNumber = differenceAmplification + 2.0 * (double) nbPoints * largestSum / std::max(size, DBL_MIN);
+    mUsesMonomialBasis = mConditionNumber * DBL_EPSILON <= tolerance;
+}
+
+
+Vec3 MonomialCurve::pointByHorner(float u) const {
+    if (mCoefficients.empty()) {
+        return BezierPointByCasteljau(mControlPoints, u);
+    }
+
+    size_t nbPoints = mCoefficients.size() / 3;
+    double point[3] = {0, 0, 0};
+
+    for (size_t k = nbPoints; k-- > 0;) {
+        for (int j = 0; j < 3; j++) {
+            point[j] = point[j] * u + mCoefficients[3 * k + j];
+        }
+    }
+
+    return Vec3(point[0], point[1], point[2]);
+}
+
+
+Vec3 MonomialCurve::pointByEstrin(float u) const {
+    if (mCoefficients.empty()) {
+        return BezierPointByCasteljau(mControlPoints, u);
+    }
+
+    size_t count = mCoefficients.size() / 3;
+
+    double terms[MONOMIAL_MAX_POINTS][3];
+    std::copy(mCoefficients.begin(), mCoefficients.end(), &terms[0][0]);
+
+    double x = u;
+
+    // Each pass folds pairs, c_2i + c_2i+1 x, then squares x
+    while (count > 1) {
+        size_t half = count / 2;
+
+        for (size_t i = 0; i < half; i++) {
+            for (int j = 0; j < 3; j++) {
+                terms[i][j] = terms[2 * i][j] + terms[2 * i + 1][j] * x;
+            }
+        }
+
+        if (count % 2 == 1) {
+            for (int j = 0; j < 3; j++) {
+                terms[half][j] = terms[count - 1][j];
+            }
+            half++;
+        }
+
+        count = half;
+        x *= x;
+    }
+
+    return Vec3(terms[0][0], terms[0][1], terms[0][2]);
+}
+
+
+Vec3 MonomialCurve::point(float u) const {
+    if (mUsesMonomialBasis) {
+        return pointByEstrin(u);
+    }
+
+    return BezierPointByCasteljau(mControlPoints, u);
+}
+
+
+std::vector<Vec3> MonomialCurve::curve(long nbU) const {
+    if (!mUsesMonomialBasis) {
+        return BezierCurveByCasteljau(mControlPoints, nbU);
+    }
+
+    std::vector<Vec3> curvePoints;
+    curvePoints.reserve(nbU);
+
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+
+        curvePoints.push_back(pointByEstrin(u));
+    }
+
+    return curvePoints;
+}
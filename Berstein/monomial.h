@@ -0,0 +1,54 @@
+//
+// Bezier curves converted once to the power (monomial) basis, for curves evaluated far more
+// often than they are edited.
+//
+
+#ifndef MODELISATION_TP1_MONOMIAL_H
+#define MODELISATION_TP1_MONOMIAL_H
+
+#include <vector>
+#include <cfloat>
+#include "../src/Vec3.h"
+
+// Past this many control points the conversion is never attempted.
+static const size_t MONOMIAL_MAX_POINTS = 32;
+
+// Relative error, to the size of the control polygon, accepted before falling back to de Casteljau.
+static const double MONOMIAL_TOLERANCE = FLT_EPSILON;
+
+class MonomialCurve {
+public:
+    explicit MonomialCurve(const std::vector<Vec3> &controlPoints, double tolerance = MONOMIAL_TOLERANCE);
+
+    // Horner's scheme, one dependent multiply-add per degree. Both schemes evaluate the
+    // coefficients even when badly conditioned, and de Casteljau when never converted.
+    Vec3 pointByHorner(float u) const;
+
+    // Estrin's scheme, pairs combined independently then merged with u^2, u^4...
+    // Shorter dependency chains, more instruction level parallelism.
+    Vec3 pointByEstrin(float u) const;
+
+    // Estrin when the conversion is accurate enough, de Casteljau on the original points otherwise.
+    Vec3 point(float u) const;
+
+    std::vector<Vec3> curve(long nbU) const;
+
+    // Estimated worst case amplification of double rounding errors by the conversion and the
+    // evaluation, relative to the size of the control polygon.
+    double conditionNumber() const { return mConditionNumber; }
+
+    bool usesMonomialBasis() const { return mUsesMonomialBasis; }
+
+    size_t degree() const { return mControlPoints.empty() ? 0 : mControlPoints.size() - 1; }
+
+private:
+    std::vector<Vec3> mControlPoints;
+
+    // mCoefficients[3 * k + j]: coefficient of u^k for coordinate j
+    std::vector<double> mCoefficients;
+
+    double mConditionNumber;
+    bool mUsesMonomialBasis;
+};
+
+#endif //MODELISATION_TP1_MONOMIAL_H
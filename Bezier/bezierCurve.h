@@ -0,0 +1,178 @@
+//
+// Bezier curves of a degree N known at compile time.
+//
+// Both evaluators are unrolled through template recursion and index sequences, binomials
+// are constexpr, so for small N the whole evaluation stays in registers.
+//
+
+#ifndef MODELISATION_TP1_BEZIERCURVE_H
+#define MODELISATION_TP1_BEZIERCURVE_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "../src/AABB.h"
+#include "../Bounds/bounds.h"
+
+constexpr long long BezierBinomial(int n, int k) {
+    return (k < 0 || k > n) ? 0 : (k == 0 || k == n) ? 1 : BezierBinomial(n - 1, k - 1) + BezierBinomial(n - 1, k);
+}
+
+// Row N of Pascal's triangle. values is a constexpr array, so it is filled at compile time
+// whatever the context it is read from.
+template<int N, typename Indices = std::make_index_sequence<N + 1> >
+struct BezierBinomials;
+
+template<int N, size_t... K>
+struct BezierBinomials<N, std::index_sequence<K...> > {
+    static constexpr long long values[N + 1] = {BezierBinomial(N, (int) K)...};
+};
+
+template<int N, size_t... K>
+constexpr long long BezierBinomials<N, std::index_sequence<K...> >::values[N + 1];
+
+// One de Casteljau level over Count points, then the next level over Count - 1.
+template<int Count, typename Scalar>
+struct BezierReduce {
+    template<size_t... I>
+    static void level(Scalar (*points)[3], Scalar u, std::index_sequence<I...>) {
+        int expand[] = {0, (lerp(points[I], points[I + 1], u), 0)...};
+        (void) expand;
+    }
+
+    static void lerp(Scalar *a, const Scalar *b, Scalar u) {
+        a[0] += (b[0] - a[0]) * u;
+        a[1] += (b[1] - a[1]) * u;
+        a[2] += (b[2] - a[2]) * u;
+    }
+
+    static void apply(Scalar (*points)[3], Scalar u) {
+        level(points, u, std::make_index_sequence<Count - 1>());
+        BezierReduce<Count - 1, Scalar>::apply(points, u);
+    }
+};
+
+template<typename Scalar>
+struct BezierReduce<1, Scalar> {
+    static void apply(Scalar (*)[3], Scalar) {}
+};
+
+template<int N, typename Scalar = float>
+class BezierCurve {
+public:
+    static_assert(N >= 1, "a Bezier curve needs at least two control points");
+
+    static const int DEGREE = N;
+    static const int NB_POINTS = N + 1;
+
+    // controlPoints must hold NB_POINTS points, of any precision.
+    template<typename U>
+    explicit BezierCurve(const Vec3T<U> *controlPoints) : mBoundsValid(false) {
+        for (int i = 0; i < NB_POINTS; i++) {
+            for (int j = 0; j < 3; j++) {
+                mPoints[i][j] = controlPoints[i][j];
+            }
+        }
+    }
+
+    Vec3T<Scalar> controlPoint(int i) const {
+        return Vec3T<Scalar>(mPoints[i][0], mPoints[i][1], mPoints[i][2]);
+    }
+
+    void setControlPoint(int i, const Vec3T<Scalar> &p) {
+        mPoints[i][0] = p[0];
+        mPoints[i][1] = p[1];
+        mPoints[i][2] = p[2];
+        mBoundsValid = false;
+    }
+
+    // Exact box of the curve, see BezierBounds. Computed on the first call after a change,
+    // so concurrent first calls on one curve must be serialized by the caller.
+    const AABBT<Scalar> &bounds() const {
+        if (!mBoundsValid) {
+            Vec3T<Scalar> points[NB_POINTS];
+
+            for (int i = 0; i < NB_POINTS; i++) {
+                points[i] = controlPoint(i);
+            }
+
+            mBounds = BezierBounds(points, NB_POINTS);
+            mBoundsValid = true;
+        }
+
+        return mBounds;
+    }
+
+    Vec3T<Scalar> pointByCasteljau(Scalar u) const {
+        Scalar points[NB_POINTS][3];
+
+        copy(points, std::make_index_sequence<NB_POINTS>());
+        BezierReduce<NB_POINTS, Scalar>::apply(points, u);
+
+        return Vec3T<Scalar>(points[0][0], points[0][1], points[0][2]);
+    }
+
+    Vec3T<Scalar> pointByBernstein(Scalar u) const {
+        return bernstein(u, std::make_index_sequence<NB_POINTS>());
+    }
+
+    std::vector<Vec3T<Scalar> > curveByCasteljau(long nbU) const {
+        std::vector<Vec3T<Scalar> > curvePoints;
+        curvePoints.reserve(nbU);
+
+        for (long i = 0; i < nbU; i++) {
+            curvePoints.push_back(pointByCasteljau((Scalar) i / (Scalar) nbU));
+        }
+
+        return curvePoints;
+    }
+
+    std::vector<Vec3T<Scalar> > curveByBernstein(long nbU) const {
+        std::vector<Vec3T<Scalar> > curvePoints;
+        curvePoints.reserve(nbU);
+
+        for (long i = 0; i < nbU; i++) {
+            curvePoints.push_back(pointByBernstein((Scalar) i / (Scalar) nbU));
+        }
+
+        return curvePoints;
+    }
+
+private:
+    template<size_t... I>
+    void copy(Scalar (*points)[3], std::index_sequence<I...>) const {
+        int expand[] = {0, (points[I][0] = mPoints[I][0], points[I][1] = mPoints[I][1], points[I][2] = mPoints[I][2], 0)...};
+        (void) expand;
+    }
+
+    template<size_t... I>
+    Vec3T<Scalar> bernstein(Scalar u, std::index_sequence<I...>) const {
+        // uPowers[i] = u^i, vPowers[i] = (1 - u)^i, filled in order by the braced lists
+        Scalar uPowers[NB_POINTS + 1] = {1};
+        Scalar vPowers[NB_POINTS + 1] = {1};
+        Scalar v = 1 - u;
+
+        Scalar expandU[] = {0, (uPowers[I + 1] = uPowers[I] * u)...};
+        Scalar expandV[] = {0, (vPowers[I + 1] = vPowers[I] * v)...};
+        (void) expandU;
+        (void) expandV;
+
+        Scalar basis[NB_POINTS] = {(Scalar) BezierBinomials<N>::values[I] * uPowers[I] * vPowers[N - I]...};
+        Scalar point[3] = {0, 0, 0};
+
+        Scalar expandSum[] = {0, (point[0] += basis[I] * mPoints[I][0],
+                                  point[1] += basis[I] * mPoints[I][1],
+                                  point[2] += basis[I] * mPoints[I][2])...};
+        (void) expandSum;
+
+        return Vec3T<Scalar>(point[0], point[1], point[2]);
+    }
+
+    Scalar mPoints[NB_POINTS][3];
+
+    mutable AABBT<Scalar> mBounds;
+    mutable bool mBoundsValid;
+};
+
+#endif //MODELISATION_TP1_BEZIERCURVE_H
@@ -0,0 +1,53 @@
+//
+// Routes Bezier evaluation to BezierCurve<N> for degrees 1 to 7, de Casteljau otherwise.
+//
+
+#include "bezierDispatch.h"
+#include "bezierCurve.h"
+#include "../Casteljau/casteljau.h"
+
+typedef std::vector<Vec3> (*CurveByDegree)(const std::vector<Vec3> &, long);
+
+typedef Vec3 (*PointByDegree)(const std::vector<Vec3> &, float);
+
+template<int N>
+static std::vector<Vec3> curveOfDegree(const std::vector<Vec3> &controlPoints, long nbU) {
+    return BezierCurve<N>(controlPoints.data()).curveByCasteljau(nbU);
+}
+
+template<int N>
+static Vec3 pointOfDegree(const std::vector<Vec3> &controlPoints, float u) {
+    return BezierCurve<N>(controlPoints.data()).pointByCasteljau(u);
+}
+
+static const CurveByDegree curveByDegree[BEZIER_MAX_SPECIALIZED_DEGREE + 1] = {
+        nullptr,
+        curveOfDegree<1>, curveOfDegree<2>, curveOfDegree<3>, curveOfDegree<4>,
+        curveOfDegree<5>, curveOfDegree<6>, curveOfDegree<7>
+};
+
+static const PointByDegree pointByDegree[BEZIER_MAX_SPECIALIZED_DEGREE + 1] = {
+        nullptr,
+        pointOfDegree<1>, pointOfDegree<2>, pointOfDegree<3>, pointOfDegree<4>,
+        pointOfDegree<5>, pointOfDegree<6>, pointOfDegree<7>
+};
+
+std::vector<Vec3> BezierCurveByDegree(const std::vector<Vec3> &controlPoints, long nbU) {
+    size_t degree = controlPoints.size() - 1;
+
+    if (controlPoints.size() < 2 || degree > BEZIER_MAX_SPECIALIZED_DEGREE) {
+        return BezierCurveByCasteljau(controlPoints, nbU);
+    }
+
+    return curveByDegree[degree](controlPoints, nbU);
+}
+
+Vec3 BezierPointByDegree(const std::vector<Vec3> &controlPoints, float u) {
+    size_t degree = controlPoints.size() - 1;
+
+    if (controlPoints.size() < 2 || degree > BEZIER_MAX_SPECIALIZED_DEGREE) {
+        return BezierPointByCasteljau(controlPoints, u);
+    }
+
+    return pointByDegree[degree](controlPoints, u);
+}
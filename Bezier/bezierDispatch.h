@@ -0,0 +1,17 @@
+//
+// Routes Bezier evaluation to BezierCurve<N> for degrees 1 to 7, de Casteljau otherwise.
+//
+
+#ifndef MODELISATION_TP1_BEZIERDISPATCH_H
+#define MODELISATION_TP1_BEZIERDISPATCH_H
+
+#include <vector>
+#include "../src/Vec3.h"
+
+static const int BEZIER_MAX_SPECIALIZED_DEGREE = 7;
+
+extern std::vector<Vec3> BezierCurveByDegree(const std::vector<Vec3> &controlPoints, long nbU);
+
+extern Vec3 BezierPointByDegree(const std::vector<Vec3> &controlPoints, float u);
+
+#endif //MODELISATION_TP1_BEZIERDISPATCH_H
@@ -0,0 +1,250 @@
+//
+// Exact bounding boxes of Bezier and Hermite curves, from the roots of the derivative.
+//
+
+#include "bounds.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Coefficient lists up to this size are halved in stack buffers
+static const size_t BOUNDS_STACK_COEFFICIENTS = 32;
+
+template<typename T>
+static void addRoot(T u, std::vector<T> &roots) {
+    if (u > 0 && u < 1) {
+        roots.push_back(u);
+    }
+}
+
+// Roots of d0 (1 - u)^2 + 2 d1 u (1 - u) + d2 u^2, or of d0 (1 - u) + d1 u when count is 2
+template<typename T>
+static void closedFormRoots(const T *d, size_t count, std::vector<T> &roots) {
+    if (count == 2) {
+        if (d[0] != d[1]) {
+            addRoot(d[0] / (d[0] - d[1]), roots);
+        }
+
+        return;
+    }
+
+    // Power basis a u^2 + b u + c
+    T a = d[0] - 2 * d[1] + d[2];
+    T b = 2 * (d[1] - d[0]);
+    T c = d[0];
+
+    if (a == 0) {
+        if (b != 0) {
+            addRoot(-c / b, roots);
+        }
+
+        return;
+    }
+
+    T discriminant = b * b - 4 * a * c;
+
+    if (discriminant < 0) {
+        return;
+    }
+
+    // No cancellation between b and the square root
+    T q = b >= 0 ? -(b + std::sqrt(discriminant)) / 2 : -(b - std::sqrt(discriminant)) / 2;
+
+    addRoot(q / a, roots);
+
+    if (q != 0) {
+        addRoot(c / q, roots);
+    }
+}
+
+// Value at u of the polynomial of Bernstein coefficients d, scratch holds count values
+template<typename T>
+static T bernsteinValue(const T *d, size_t count, T u, T *scratch) {
+    std::copy(d, d + count, scratch);
+
+    for (size_t level = count; level > 1; level--) {
+        for (size_t i = 0; i + 1 < level; i++) {
+            scratch[i] += (scratch[i + 1] - scratch[i]) * u;
+        }
+    }
+
+    return scratch[0];
+}
+
+template<typename T>
+static int signChanges(const T *d, size_t count) {
+    int changes = 0;
+    int previous = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        int sign = d[i] > 0 ? 1 : (d[i] < 0 ? -1 : 0);
+
+        if (sign != 0) {
+            changes += previous != 0 && sign != previous;
+            previous = sign;
+        }
+    }
+
+    return changes;
+}
+
+// d holds the coefficients of the derivative component restricted to [u0, u1], buffers[depth] the halves
+template<typename T>
+static void isolateRoots(const T *d, size_t count, T u0, T u1, int depth,
+                         std::vector<std::vector<T> > &buffers, std::vector<T> &roots) {
+    int changes = signChanges(d, count);
+
+    // Variation diminishing: at most as many roots as sign changes
+    if (changes == 0) {
+        return;
+    }
+
+    if (buffers.size() <= (size_t) depth) {
+        buffers.resize(depth + 1);
+    }
+
+    std::vector<T> &buffer = buffers[depth];
+    buffer.resize(3 * count);
+
+    if (changes == 1 && d[0] * d[count - 1] < 0) {
+        // Exactly one root, bisected on the local parameter
+        T low = 0;
+        T high = 1;
+        bool lowNegative = d[0] < 0;
+
+        for (int step = 0; step < BOUNDS_BISECTION_STEPS; step++) {
+            T middle = (low + high) / 2;
+
+            if ((bernsteinValue(d, count, middle, buffer.data()) < 0) == lowNegative) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+
+        addRoot(u0 + (low + high) / 2 * (u1 - u0), roots);
+        return;
+    }
+
+    T middle = (u0 + u1) / 2;
+
+    if (depth >= BOUNDS_MAX_DEPTH) {
+        addRoot(middle, roots);
+        return;
+    }
+
+    // Scalar de Casteljau split at 1 / 2: left takes the first column, right the last one
+    T *scratch = buffer.data();
+    T *left = scratch + count;
+    T *right = left + count;
+
+    std::copy(d, d + count, scratch);
+
+    for (size_t level = count; level > 0; level--) {
+        left[count - level] = scratch[0];
+        right[level - 1] = scratch[level - 1];
+
+        for (size_t i = 0; i + 1 < level; i++) {
+            scratch[i] = (scratch[i] + scratch[i + 1]) / 2;
+        }
+    }
+
+    // A root right on the split point shows as a zero end coefficient in both halves
+    if (left[count - 1] == 0) {
+        addRoot(middle, roots);
+    }
+
+    isolateRoots(left, count, u0, middle, depth + 1, buffers, roots);
+    isolateRoots(right, count, middle, u1, depth + 1, buffers, roots);
+}
+
+template<typename T>
+void BezierDerivativeRoots(const Vec3T<T> *controlPoints, size_t count, unsigned int axis, std::vector<T> &roots) {
+    if (count < 3) {
+        // Lines reach their extremes at their ends
+        return;
+    }
+
+    // The derivative's Bernstein coefficients, without the degree factor which does not move roots
+    size_t nbCoefficients = count - 1;
+    T stackCoefficients[BOUNDS_STACK_COEFFICIENTS];
+    std::vector<T> heapCoefficients;
+    T *d = stackCoefficients;
+
+    if (nbCoefficients > BOUNDS_STACK_COEFFICIENTS) {
+        heapCoefficients.resize(nbCoefficients);
+        d = heapCoefficients.data();
+    }
+
+    for (size_t i = 0; i < nbCoefficients; i++) {
+        d[i] = controlPoints[i + 1][axis] - controlPoints[i][axis];
+    }
+
+    if (nbCoefficients <= 3) {
+        closedFormRoots(d, nbCoefficients, roots);
+        return;
+    }
+
+    std::vector<std::vector<T> > buffers;
+    isolateRoots(d, nbCoefficients, (T) 0, (T) 1, 0, buffers, roots);
+}
+
+template<typename T>
+AABBT<T> BezierBounds(const Vec3T<T> *controlPoints, size_t count) {
+    AABBT<T> box;
+
+    if (count == 0) {
+        return box;
+    }
+
+    box.extend(controlPoints[0]);
+    box.extend(controlPoints[count - 1]);
+
+    // Every control point inside the box already: no derivative root can push it out
+    AABBT<T> hull = AABBT<T>::ofPoints(controlPoints, count);
+    std::vector<T> roots;
+
+    for (unsigned int axis = 0; axis < 3; axis++) {
+        if (hull.min[axis] < box.min[axis] || hull.max[axis] > box.max[axis]) {
+            BezierDerivativeRoots(controlPoints, count, axis, roots);
+        }
+    }
+
+    if (roots.empty()) {
+        return box;
+    }
+
+    std::vector<Vec3T<T> > curve(controlPoints, controlPoints + count);
+    CasteljauWorkspaceT<T> workspace;
+
+    for (size_t i = 0; i < roots.size(); i++) {
+        box.extend(BezierPointByCasteljau(curve, roots[i], workspace));
+    }
+
+    return box;
+}
+
+template<typename T>
+AABBT<T> BezierBounds(const std::vector<Vec3T<T> > &controlPoints) {
+    return BezierBounds(controlPoints.data(), controlPoints.size());
+}
+
+template<typename T>
+AABBT<T> HermiteBounds(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1) {
+    Vec3T<T> bezier[4];
+    HermiteToBezier(p0, p1, v0, v1, bezier);
+
+    return BezierBounds(bezier, 4);
+}
+
+#define INSTANTIATE_BOUNDS(T) \
+    template void BezierDerivativeRoots<T>(const Vec3T<T> *, size_t, unsigned int, std::vector<T> &); \
+    template AABBT<T> BezierBounds<T>(const Vec3T<T> *, size_t); \
+    template AABBT<T> BezierBounds<T>(const std::vector<Vec3T<T> > &); \
+    template AABBT<T> HermiteBounds<T>(const Vec3T<T> &, const Vec3T<T> &, const Vec3T<T> &, const Vec3T<T> &);
+
+INSTANTIATE_BOUNDS(float)
+INSTANTIATE_BOUNDS(double)
+INSTANTIATE_BOUNDS(long double)
@@ -0,0 +1,37 @@
+//
+// Exact bounding boxes of Bezier and Hermite curves, from the roots of the derivative.
+//
+
+#ifndef MODELISATION_TP1_BOUNDS_H
+#define MODELISATION_TP1_BOUNDS_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "../src/AABB.h"
+
+// Everything here is instantiated for float, double and long double in bounds.cpp.
+
+// Past this depth, or past this many bisections, an isolating interval is taken as it is.
+// Candidates are curve points, so an imprecise one can only shrink the box by a second order term.
+static const int BOUNDS_MAX_DEPTH = 32;
+static const int BOUNDS_BISECTION_STEPS = 48;
+
+// Parameters in (0, 1) where component axis of the curve's derivative vanishes, appended to roots.
+// Closed form while the derivative is at most quadratic, cubic curves included. Above, the
+// derivative's Bernstein coefficients are halved until each interval shows no sign change,
+// so no root, or a single one, which is then bisected.
+template<typename T>
+void BezierDerivativeRoots(const Vec3T<T> *controlPoints, size_t count, unsigned int axis, std::vector<T> &roots);
+
+// Smallest box holding the curve: its end points and its points at every derivative root.
+template<typename T>
+AABBT<T> BezierBounds(const Vec3T<T> *controlPoints, size_t count);
+
+template<typename T>
+AABBT<T> BezierBounds(const std::vector<Vec3T<T> > &controlPoints);
+
+template<typename T>
+AABBT<T> HermiteBounds(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1);
+
+#endif //MODELISATION_TP1_BOUNDS_H
@@ -4,38 +4,303 @@
 
 #include "casteljau.h"
 
-std::vector<Vec3> BezierCurveByCasteljau(const std::vector<Vec3> &controlPoints, const long nbU) {
-    std::vector<Vec3> curvePoints;
+#include <algorithm>
+
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const long nbU) {
+    std::vector<Vec3T<T> > curvePoints;
+    curvePoints.reserve(nbU);
+
+    CasteljauWorkspaceT<T> workspace;
 
     for (int i = 0; i < nbU; i++) {
-        float u = (float) i / (float) nbU;
+        T u = (T) i / (T) nbU;
 
         curvePoints.push_back(
-                BezierPointByCasteljau(controlPoints, u)
+                BezierPointByCasteljau(controlPoints, u, workspace)
         );
     }
 
     return curvePoints;
 }
 
-Vec3 BezierPointByCasteljau(const std::vector<Vec3> &controlPoints, const float u) {
-    std::vector<Vec3> subControlPoints;
-    std::vector<Vec3> nextSubControlPoints = controlPoints;;
+void BezierCurveByCasteljau(const std::vector<Vec3> &controlPoints, const long nbU, Vec3Array &out) {
+    out.resize(nbU > 0 ? nbU : 0);
+
+    CasteljauWorkspace workspace;
 
-    while (nextSubControlPoints.size() > 1) {
-        subControlPoints = nextSubControlPoints;
-        nextSubControlPoints.clear();
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+
+        out.set(i, BezierPointByCasteljau(controlPoints, u, workspace));
+    }
+}
+
+template<typename T>
+Vec3T<T> BezierPointByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const typename NonDeduced<T>::type u) {
+    CasteljauWorkspaceT<T> workspace;
+
+    return BezierPointByCasteljau(controlPoints, u, workspace);
+}
+
+template<typename T>
+Vec3T<T> BezierPointByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const typename NonDeduced<T>::type u,
+                                CasteljauWorkspaceT<T> &workspace) {
+    if (controlPoints.empty()) {
+        return Vec3T<T>(0, 0, 0);
+    }
 
-        for (int i = 0; i < subControlPoints.size() - 1; i++) {
-            Vec3 point;
-            Vec3 v = subControlPoints[i + 1] - subControlPoints[i];
-            v *= u;
+    Vec3T<T> stackPoints[CASTELJAU_STACK_POINTS];
+    Vec3T<T> *points = controlPoints.size() <= CASTELJAU_STACK_POINTS
+                       ? stackPoints
+                       : workspace.acquire(controlPoints.size());
 
-            point = subControlPoints[i] + v;
+    std::copy(controlPoints.begin(), controlPoints.end(), points);
 
-            nextSubControlPoints.push_back(point);
+    return CasteljauReduce(points, controlPoints.size(), u);
+}
+
+template<typename T>
+static T distanceToSegment(const Vec3T<T> &p, const Vec3T<T> &a, const Vec3T<T> &b) {
+    Vec3T<T> ab = b - a;
+    Vec3T<T> ap = p - a;
+    T squareLength = ab.squareLength();
+
+    if (squareLength == 0) {
+        return ap.length();
+    }
+
+    T t = std::max((T) 0, std::min((T) 1, Vec3T<T>::dot(ap, ab) / squareLength));
+
+    return (ap - t * ab).length();
+}
+
+template<typename T>
+static bool isFlat(const Vec3T<T> *points, size_t count, T tolerance,
+                   const std::function<Vec3T<T>(const Vec3T<T> &)> *project) {
+    if (project) {
+        Vec3T<T> first = (*project)(points[0]);
+        Vec3T<T> last = (*project)(points[count - 1]);
+
+        for (size_t i = 1; i + 1 < count; i++) {
+            if (distanceToSegment((*project)(points[i]), first, last) > tolerance) {
+                return false;
+            }
         }
+
+        return true;
     }
 
-    return nextSubControlPoints[0];
+    for (size_t i = 1; i + 1 < count; i++) {
+        if (distanceToSegment(points[i], points[0], points[count - 1]) > tolerance) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// buffers[depth] holds 3 polygons: scratch, left half, right half
+template<typename T>
+static void subdivide(const Vec3T<T> *points, size_t count, T tolerance,
+                      const std::function<Vec3T<T>(const Vec3T<T> &)> *project,
+                      int depth, std::vector<std::vector<Vec3T<T> > > &buffers, std::vector<Vec3T<T> > &curvePoints) {
+    if (depth >= ADAPTIVE_MAX_DEPTH || isFlat(points, count, tolerance, project)) {
+        curvePoints.push_back(points[count - 1]);
+        return;
+    }
+
+    if (buffers.size() <= (size_t) depth) {
+        buffers.resize(depth + 1);
+    }
+
+    std::vector<Vec3T<T> > &buffer = buffers[depth];
+    buffer.resize(3 * count);
+
+    Vec3T<T> *scratch = buffer.data();
+    Vec3T<T> *left = scratch + count;
+    Vec3T<T> *right = left + count;
+
+    std::copy(points, points + count, scratch);
+    CasteljauSplit(scratch, count, (T) 0.5, left, right);
+
+    subdivide(left, count, tolerance, project, depth + 1, buffers, curvePoints);
+    subdivide(right, count, tolerance, project, depth + 1, buffers, curvePoints);
+}
+
+template<typename T>
+static std::vector<Vec3T<T> > adaptive(const std::vector<Vec3T<T> > &controlPoints, T tolerance,
+                                       const std::function<Vec3T<T>(const Vec3T<T> &)> *project) {
+    std::vector<Vec3T<T> > curvePoints;
+
+    if (controlPoints.empty()) {
+        return curvePoints;
+    }
+
+    curvePoints.push_back(controlPoints[0]);
+
+    if (controlPoints.size() == 1) {
+        return curvePoints;
+    }
+
+    std::vector<std::vector<Vec3T<T> > > buffers;
+    subdivide(controlPoints.data(), controlPoints.size(), tolerance, project, 0, buffers, curvePoints);
+
+    return curvePoints;
+}
+
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveAdaptive(const std::vector<Vec3T<T> > &controlPoints,
+                                           const typename NonDeduced<T>::type tolerance) {
+    return adaptive<T>(controlPoints, tolerance, nullptr);
+}
+
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveAdaptive(const std::vector<Vec3T<T> > &controlPoints,
+                                           const typename NonDeduced<T>::type tolerance,
+                                           const typename NonDeduced<std::function<Vec3T<T>(const Vec3T<T> &)> >::type &project) {
+    return adaptive<T>(controlPoints, tolerance, &project);
 }
+
+template<typename T>
+void CasteljauSplit(Vec3T<T> *points, size_t count, const typename NonDeduced<T>::type u,
+                    Vec3T<T> *left, Vec3T<T> *right) {
+    for (size_t level = 0; level < count; level++) {
+        size_t levelCount = count - level;
+
+        left[level] = points[0];
+        right[levelCount - 1] = points[levelCount - 1];
+
+        if (levelCount > 1) {
+            CasteljauLevel(points, levelCount, u);
+        }
+    }
+}
+
+template<typename T>
+CurveDifferentialsT<T> BezierDifferentialsByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const long nbU) {
+    CurveDifferentialsT<T> differentials;
+    differentials.resize(nbU);
+
+    CasteljauWorkspaceT<T> workspace;
+
+    for (int i = 0; i < nbU; i++) {
+        T u = (T) i / (T) nbU;
+
+        BezierPointDifferentialsByCasteljau(controlPoints, u,
+                                            differentials.positions[i],
+                                            differentials.firstDerivatives[i],
+                                            differentials.secondDerivatives[i],
+                                            workspace);
+
+        differentials.curvatures[i] = Curvature(differentials.firstDerivatives[i], differentials.secondDerivatives[i]);
+    }
+
+    return differentials;
+}
+
+template<typename T>
+void BezierPointDifferentialsByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const typename NonDeduced<T>::type u,
+                                         Vec3T<T> &position, Vec3T<T> &firstDerivative, Vec3T<T> &secondDerivative,
+                                         CasteljauWorkspaceT<T> &workspace) {
+    if (controlPoints.empty()) {
+        position = Vec3T<T>(0, 0, 0);
+        firstDerivative = Vec3T<T>(0, 0, 0);
+        secondDerivative = Vec3T<T>(0, 0, 0);
+        return;
+    }
+
+    Vec3T<T> stackPoints[CASTELJAU_STACK_POINTS];
+    Vec3T<T> *points = controlPoints.size() <= CASTELJAU_STACK_POINTS
+                       ? stackPoints
+                       : workspace.acquire(controlPoints.size());
+
+    std::copy(controlPoints.begin(), controlPoints.end(), points);
+
+    position = CasteljauReduce(points, controlPoints.size(), u, firstDerivative, secondDerivative);
+}
+
+template<typename T>
+Vec3T<T> CasteljauReduce(Vec3T<T> *points, size_t count, const typename NonDeduced<T>::type u) {
+    // Each level overwrites points[i] once points[i] and points[i + 1] have been read,
+    // so the whole pyramid fits in the control polygon's own storage.
+    while (count > 1) {
+        CasteljauLevel(points, count, u);
+        count--;
+    }
+
+    return points[0];
+}
+
+template<typename T>
+Vec3T<T> CasteljauReduce(Vec3T<T> *points, size_t count, const typename NonDeduced<T>::type u,
+                         Vec3T<T> &firstDerivative, Vec3T<T> &secondDerivative) {
+    T degree = (T) count - 1;
+
+    firstDerivative = Vec3T<T>(0, 0, 0);
+    secondDerivative = Vec3T<T>(0, 0, 0);
+
+    while (count > 1) {
+        if (count == 3) {
+            secondDerivative = points[2] - 2 * points[1] + points[0];
+            secondDerivative *= degree * (degree - 1);
+        }
+
+        if (count == 2) {
+            firstDerivative = points[1] - points[0];
+            firstDerivative *= degree;
+        }
+
+        CasteljauLevel(points, count, u);
+        count--;
+    }
+
+    return points[0];
+}
+
+template<typename T>
+void CasteljauLevel(Vec3T<T> *points, size_t count, const typename NonDeduced<T>::type u) {
+    CasteljauLevel(points, count, u, points);
+}
+
+template<typename T>
+void CasteljauLevel(const Vec3T<T> *source, size_t count, const typename NonDeduced<T>::type u, Vec3T<T> *destination) {
+    CasteljauLerpLevel(source, count, u, destination);
+}
+
+template<typename T>
+void CasteljauPyramidT<T>::compute(const std::vector<Vec3T<T> > &controlPoints, const T u) {
+    mNbPoints = controlPoints.size();
+
+    size_t size = mNbPoints * (mNbPoints + 1) / 2;
+    if (mPoints.size() < size) {
+        mPoints.resize(size);
+    }
+
+    std::copy(controlPoints.begin(), controlPoints.end(), mPoints.begin());
+
+    for (size_t level = 0; level + 1 < mNbPoints; level++) {
+        CasteljauLevel(mPoints.data() + offset(level), levelSize(level), u, mPoints.data() + offset(level + 1));
+    }
+}
+
+#define INSTANTIATE_CASTELJAU(T) \
+    template std::vector<Vec3T<T> > BezierCurveByCasteljau<T>(const std::vector<Vec3T<T> > &, long); \
+    template Vec3T<T> BezierPointByCasteljau<T>(const std::vector<Vec3T<T> > &, T); \
+    template Vec3T<T> BezierPointByCasteljau<T>(const std::vector<Vec3T<T> > &, T, CasteljauWorkspaceT<T> &); \
+    template std::vector<Vec3T<T> > BezierCurveAdaptive<T>(const std::vector<Vec3T<T> > &, T); \
+    template std::vector<Vec3T<T> > BezierCurveAdaptive<T>(const std::vector<Vec3T<T> > &, T, \
+                                                           const std::function<Vec3T<T>(const Vec3T<T> &)> &); \
+    template void CasteljauSplit<T>(Vec3T<T> *, size_t, T, Vec3T<T> *, Vec3T<T> *); \
+    template CurveDifferentialsT<T> BezierDifferentialsByCasteljau<T>(const std::vector<Vec3T<T> > &, long); \
+    template void BezierPointDifferentialsByCasteljau<T>(const std::vector<Vec3T<T> > &, T, \
+                                                         Vec3T<T> &, Vec3T<T> &, Vec3T<T> &, CasteljauWorkspaceT<T> &); \
+    template Vec3T<T> CasteljauReduce<T>(Vec3T<T> *, size_t, T); \
+    template Vec3T<T> CasteljauReduce<T>(Vec3T<T> *, size_t, T, Vec3T<T> &, Vec3T<T> &); \
+    template void CasteljauLevel<T>(Vec3T<T> *, size_t, T); \
+    template void CasteljauLevel<T>(const Vec3T<T> *, size_t, T, Vec3T<T> *); \
+    template class CasteljauPyramidT<T>;
+
+INSTANTIATE_CASTELJAU(float)
+INSTANTIATE_CASTELJAU(double)
+INSTANTIATE_CASTELJAU(long double)
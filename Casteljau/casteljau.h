@@ -6,10 +6,138 @@
 #define MODELISATION_TP1_CASTELJAU_H
 
 #include <vector>
+#include <cstddef>
+#include <functional>
 #include "../src/Vec3.h"
+#include "../src/CurveDifferentials.h"
+#include "../Simd/vec3Array.h"
 
-extern std::vector<Vec3> BezierCurveByCasteljau(const std::vector<Vec3> &controlPoints, long nbU);
+// Everything here is instantiated for float, double and long double in casteljau.cpp.
 
-extern Vec3 BezierPointByCasteljau(const std::vector<Vec3> &controlPoints, float u);
+// Control polygons up to this size are reduced in a stack buffer,
+// larger ones go through a CasteljauWorkspace.
+static const size_t CASTELJAU_STACK_POINTS = 16;
+
+// Reusable scratch buffer for de Casteljau reductions of large control polygons.
+// It only grows, so evaluating many curves of the same size allocates once.
+template<typename T>
+class CasteljauWorkspaceT {
+public:
+    Vec3T<T> *acquire(size_t count) {
+        if (mBuffer.size() < count) {
+            mBuffer.resize(count);
+        }
+
+        return mBuffer.data();
+    }
+
+private:
+    std::vector<Vec3T<T> > mBuffer;
+};
+
+typedef CasteljauWorkspaceT<float> CasteljauWorkspace;
+
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveByCasteljau(const std::vector<Vec3T<T> > &controlPoints, long nbU);
+
+// The same points in float, written straight into out's lanes, resized to nbU points.
+extern void BezierCurveByCasteljau(const std::vector<Vec3> &controlPoints, long nbU, Vec3Array &out);
+
+template<typename T>
+Vec3T<T> BezierPointByCasteljau(const std::vector<Vec3T<T> > &controlPoints, typename NonDeduced<T>::type u);
+
+template<typename T>
+Vec3T<T> BezierPointByCasteljau(const std::vector<Vec3T<T> > &controlPoints, typename NonDeduced<T>::type u,
+                                CasteljauWorkspaceT<T> &workspace);
+
+// Past this depth a piece is accepted whatever its flatness.
+static const int ADAPTIVE_MAX_DEPTH = 24;
+
+// Polyline from u = 0 to u = 1 within tolerance of the curve: the curve is split in halves
+// until every piece's control polygon lies within tolerance of its chord, which by the
+// convex hull property bounds the distance between the curve and that chord.
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveAdaptive(const std::vector<Vec3T<T> > &controlPoints,
+                                           typename NonDeduced<T>::type tolerance);
+
+// Same, with the flatness measured on the projected control points, e.g. a tolerance in pixels
+// once project maps to screen space. Exact for affine projections, a close estimate for
+// perspective ones since pieces become small.
+template<typename T>
+std::vector<Vec3T<T> > BezierCurveAdaptive(const std::vector<Vec3T<T> > &controlPoints,
+                                           typename NonDeduced<T>::type tolerance,
+                                           const typename NonDeduced<std::function<Vec3T<T>(const Vec3T<T> &)> >::type &project);
+
+// Both halves of the curve at u, left[0] = points[0] and right[count - 1] = points[count - 1].
+// points is used as scratch and left holds the pyramid's first column, right its last one.
+template<typename T>
+void CasteljauSplit(Vec3T<T> *points, size_t count, typename NonDeduced<T>::type u, Vec3T<T> *left, Vec3T<T> *right);
+
+// Position, derivatives and curvature at every u = i / nbU, in one reduction per sample.
+template<typename T>
+CurveDifferentialsT<T> BezierDifferentialsByCasteljau(const std::vector<Vec3T<T> > &controlPoints, long nbU);
+
+template<typename T>
+void BezierPointDifferentialsByCasteljau(const std::vector<Vec3T<T> > &controlPoints, typename NonDeduced<T>::type u,
+                                         Vec3T<T> &position, Vec3T<T> &firstDerivative, Vec3T<T> &secondDerivative,
+                                         CasteljauWorkspaceT<T> &workspace);
+
+// Reduces the count points in place, level after level, and returns the point of the curve at u.
+template<typename T>
+Vec3T<T> CasteljauReduce(Vec3T<T> *points, size_t count, typename NonDeduced<T>::type u);
+
+// Same reduction, also reading both derivatives off the last levels of the pyramid:
+// c'(u) = n (b1 - b0) on the level of 2 points, c''(u) = n (n - 1) (b2 - 2 b1 + b0) on the level of 3.
+template<typename T>
+Vec3T<T> CasteljauReduce(Vec3T<T> *points, size_t count, typename NonDeduced<T>::type u,
+                         Vec3T<T> &firstDerivative, Vec3T<T> &secondDerivative);
+
+// One level: points[i] = lerp(points[i], points[i + 1], u) for i < count - 1.
+template<typename T>
+void CasteljauLevel(Vec3T<T> *points, size_t count, typename NonDeduced<T>::type u);
+
+// Same, reading count points from source and writing count - 1 points to destination.
+// destination may be source itself.
+template<typename T>
+void CasteljauLevel(const Vec3T<T> *source, size_t count, typename NonDeduced<T>::type u, Vec3T<T> *destination);
+
+// The loop behind CasteljauLevel, for any point type with a static lerp rounding like Vec3T::lerp,
+// e.g. the homogeneous points of rational curves. destination may be source itself.
+template<typename Point, typename Scalar>
+inline void CasteljauLerpLevel(const Point *source, size_t count, Scalar u, Point *destination) {
+    for (size_t i = 0; i + 1 < count; i++) {
+        destination[i] = Point::lerp(source[i], source[i + 1], u);
+    }
+}
+
+// Every level of the de Casteljau construction at u, in one triangular buffer:
+// level 0 is the control polygon, level k holds nbPoints - k points, the last one is the curve point.
+// The buffer only grows, so recomputing for another u or a same sized polygon does not allocate.
+template<typename T>
+class CasteljauPyramidT {
+public:
+    CasteljauPyramidT() : mNbPoints(0) {}
+
+    void compute(const std::vector<Vec3T<T> > &controlPoints, T u);
+
+    size_t nbLevels() const { return mNbPoints; }
+
+    size_t levelSize(size_t level) const { return mNbPoints - level; }
+
+    const Vec3T<T> *level(size_t level) const { return mPoints.data() + offset(level); }
+
+    const Vec3T<T> &at(size_t level, size_t i) const { return mPoints[offset(level) + i]; }
+
+    const Vec3T<T> &curvePoint() const { return at(mNbPoints - 1, 0); }
+
+private:
+    // Sum of the sizes of the levels before it
+    size_t offset(size_t level) const { return level * mNbPoints - level * (level - 1) / 2; }
+
+    std::vector<Vec3T<T> > mPoints;
+    size_t mNbPoints;
+};
+
+typedef CasteljauPyramidT<float> CasteljauPyramid;
 
 #endif //MODELISATION_TP1_CASTELJAU_H
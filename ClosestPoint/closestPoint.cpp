@@ -0,0 +1,260 @@
+//
+// Closest point queries against many curves, through a bounding volume hierarchy of curve pieces.
+//
+
+#include "closestPoint.h"
+#include "../Casteljau/casteljau.h"
+#include "../Bounds/bounds.h"
+#include "../Hermite/hermite.h"
+
+#include <algorithm>
+#include <limits>
+
+// Depth of the traversal stack, the hierarchy is balanced so log2 of the number of pieces
+static const size_t CLOSEST_POINT_STACK_SIZE = 64;
+
+static float distanceToLine(const Vec3 &p, const Vec3 &a, const Vec3 &b) {
+    Vec3 ab = b - a;
+    Vec3 ap = p - a;
+    float squareLength = ab.squareLength();
+
+    if (squareLength == 0) {
+        return ap.length();
+    }
+
+    return (ap - (Vec3::dot(ap, ab) / squareLength) * ab).length();
+}
+
+static bool isFlat(const Vec3 *points, size_t count) {
+    float tolerance = CLOSEST_POINT_FLATNESS * (points[count - 1] - points[0]).length();
+
+    for (size_t i = 1; i + 1 < count; i++) {
+        if (distanceToLine(points[i], points[0], points[count - 1]) > tolerance) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ClosestPointIndex::ClosestPointIndex(const CurveBatch &curves, CurveEngine engine) : mOffsets(1, 0), mMaxPoints(0) {
+    for (size_t c = 0; c < curves.size(); c++) {
+        const Vec3 *controlPoints = curves.points.data() + curves.offsets[c];
+        size_t nbPoints = curves.offsets[c + 1] - curves.offsets[c];
+
+        if (engine == ENGINE_HERMITE) {
+            // Malformed entries keep an empty range, like empty curves
+            if (nbPoints == 4) {
+                Vec3 bezier[4];
+                HermiteToBezier(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3], bezier);
+                mPoints.insert(mPoints.end(), bezier, bezier + 4);
+            }
+        } else {
+            mPoints.insert(mPoints.end(), controlPoints, controlPoints + nbPoints);
+        }
+
+        mMaxPoints = std::max(mMaxPoints, mPoints.size() - mOffsets.back());
+        mOffsets.push_back(mPoints.size());
+    }
+
+    for (size_t c = 0; c + 1 < mOffsets.size(); c++) {
+        if (mOffsets[c + 1] > mOffsets[c]) {
+            addPieces(c, mPoints.data() + mOffsets[c], 0, 1, 0);
+        }
+    }
+
+    if (!mPieces.empty()) {
+        build(0, mPieces.size());
+    }
+}
+
+void ClosestPointIndex::addPieces(size_t curve, const Vec3 *points, float u0, float u1, int depth) {
+    size_t count = mOffsets[curve + 1] - mOffsets[curve];
+
+    if (depth >= CLOSEST_POINT_MAX_DEPTH || isFlat(points, count)) {
+        Piece piece;
+        piece.curve = curve;
+        piece.u0 = u0;
+        piece.u1 = u1;
+        piece.offset = mPiecePoints.size();
+        piece.box = BezierBounds(points, count);
+
+        mPiecePoints.insert(mPiecePoints.end(), points, points + count);
+        mPieces.push_back(piece);
+        return;
+    }
+
+    // Scratch, left half, right half
+    std::vector<Vec3> halves(3 * count);
+    std::copy(points, points + count, halves.begin());
+    CasteljauSplit(halves.data(), count, 0.5f, halves.data() + count, halves.data() + 2 * count);
+
+    float middle = (u0 + u1) / 2;
+
+    addPieces(curve, halves.data() + count, u0, middle, depth + 1);
+    addPieces(curve, halves.data() + 2 * count, middle, u1, depth + 1);
+}
+
+size_t ClosestPointIndex::build(size_t begin, size_t end) {
+    size_t index = mNodes.size();
+    mNodes.push_back(Node());
+
+    AABB box;
+    AABB centers;
+
+    for (size_t i = begin; i < end; i++) {
+        box.extend(mPieces[i].box);
+        centers.extend(mPieces[i].box.center());
+    }
+
+    mNodes[index].box = box;
+
+    if (end - begin <= CLOSEST_POINT_LEAF_SIZE) {
+        mNodes[index].first = begin;
+        mNodes[index].count = end - begin;
+        return index;
+    }
+
+    // Median split on the axis where the pieces spread the most
+    Vec3 spread = centers.extent();
+    unsigned int axis = spread[0] >= spread[1] ? (spread[0] >= spread[2] ? 0 : 2) : (spread[1] >= spread[2] ? 1 : 2);
+    size_t middle = (begin + end) / 2;
+
+    std::nth_element(mPieces.begin() + begin, mPieces.begin() + middle, mPieces.begin() + end,
+                     [axis](const Piece &a, const Piece &b) {
+                         return a.box.center()[axis] < b.box.center()[axis];
+                     });
+
+    build(begin, middle);
+    size_t right = build(middle, end);
+
+    mNodes[index].first = right;
+    mNodes[index].count = 0;
+
+    return index;
+}
+
+void ClosestPointIndex::refine(const Piece &piece, const Vec3 &point, ClosestPoint &best, float &bestSquareDistance,
+                               Vec3 *scratch) const {
+    const Vec3 *piecePoints = mPiecePoints.data() + piece.offset;
+    const Vec3 *curvePoints = mPoints.data() + mOffsets[piece.curve];
+    size_t count = mOffsets[piece.curve + 1] - mOffsets[piece.curve];
+
+    // Guess from the chord, close to the piece since it is flat
+    Vec3 chord = piecePoints[count - 1] - piecePoints[0];
+    float squareLength = chord.squareLength();
+    float t = squareLength > 0 ? Vec3::dot(point - piecePoints[0], chord) / squareLength : 0;
+    float u = piece.u0 + std::max(0.0f, std::min(1.0f, t)) * (piece.u1 - piece.u0);
+
+    Vec3 position, firstDerivative, secondDerivative;
+
+    for (int step = 0; step < CLOSEST_POINT_NEWTON_STEPS; step++) {
+        std::copy(curvePoints, curvePoints + count, scratch);
+        position = CasteljauReduce(scratch, count, u, firstDerivative, secondDerivative);
+
+        Vec3 offset = position - point;
+        float f = Vec3::dot(offset, firstDerivative);
+        float slope = Vec3::dot(firstDerivative, firstDerivative) + Vec3::dot(offset, secondDerivative);
+
+        if (slope <= 0) {
+            break;
+        }
+
+        float next = std::max(piece.u0, std::min(piece.u1, u - f / slope));
+
+        if (next == u) {
+            break;
+        }
+
+        u = next;
+    }
+
+    std::copy(curvePoints, curvePoints + count, scratch);
+    position = CasteljauReduce(scratch, count, u);
+
+    float squareDistance = (position - point).squareLength();
+
+    if (squareDistance < bestSquareDistance) {
+        bestSquareDistance = squareDistance;
+        best.curve = piece.curve;
+        best.u = u;
+        best.point = position;
+    }
+}
+
+ClosestPoint ClosestPointIndex::query(const Vec3 &point, Vec3 *scratch) const {
+    ClosestPoint best;
+    best.curve = NO_CURVE;
+    best.u = 0;
+    best.distance = std::numeric_limits<float>::infinity();
+    best.point = point;
+
+    if (mNodes.empty()) {
+        return best;
+    }
+
+    float bestSquareDistance = std::numeric_limits<float>::infinity();
+    size_t stack[CLOSEST_POINT_STACK_SIZE];
+    size_t size = 0;
+
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const Node &node = mNodes[stack[--size]];
+
+        if (node.box.squareDistance(point) >= bestSquareDistance) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (size_t i = node.first; i < node.first + node.count; i++) {
+                if (mPieces[i].box.squareDistance(point) < bestSquareDistance) {
+                    refine(mPieces[i], point, best, bestSquareDistance, scratch);
+                }
+            }
+
+            continue;
+        }
+
+        size_t left = &node - mNodes.data() + 1;
+        size_t right = node.first;
+
+        // Nearest child on top of the stack
+        if (mNodes[left].box.squareDistance(point) < mNodes[right].box.squareDistance(point)) {
+            std::swap(left, right);
+        }
+
+        stack[size++] = left;
+        stack[size++] = right;
+    }
+
+    best.distance = std::sqrt(bestSquareDistance);
+
+    return best;
+}
+
+ClosestPoint ClosestPointIndex::closestPoint(const Vec3 &point) const {
+    std::vector<Vec3> scratch(mMaxPoints);
+
+    return query(point, scratch.data());
+}
+
+void ClosestPointIndex::closestPoints(const Vec3 *points, size_t count, ClosestPoint *out, ThreadPool &pool) const {
+    RangeTask task = [&](size_t begin, size_t end) {
+        std::vector<Vec3> scratch(mMaxPoints);
+
+        for (size_t i = begin; i < end; i++) {
+            out[i] = query(points[i], scratch.data());
+        }
+    };
+
+    pool.parallelFor(count, CLOSEST_POINT_GRAIN, task);
+}
+
+std::vector<ClosestPoint> ClosestPointIndex::closestPoints(const std::vector<Vec3> &points) const {
+    std::vector<ClosestPoint> result(points.size());
+
+    closestPoints(points.data(), points.size(), result.data(), DefaultThreadPool());
+
+    return result;
+}
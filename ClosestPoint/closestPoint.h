@@ -0,0 +1,97 @@
+//
+// Closest point queries against many curves, through a bounding volume hierarchy of curve pieces.
+//
+
+#ifndef MODELISATION_TP1_CLOSESTPOINT_H
+#define MODELISATION_TP1_CLOSESTPOINT_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "../src/AABB.h"
+#include "../Batch/batch.h"
+#include "../Batch/threadPool.h"
+
+// curve is NO_CURVE when the index is empty.
+struct ClosestPoint {
+    size_t curve;
+    float u;
+    float distance;
+    Vec3 point;
+};
+
+static const size_t NO_CURVE = (size_t) -1;
+
+// Halvings of a curve into pieces, a piece stops once its control polygon is flat within
+// CLOSEST_POINT_FLATNESS times its chord.
+static const int CLOSEST_POINT_MAX_DEPTH = 8;
+static const float CLOSEST_POINT_FLATNESS = 0.05f;
+
+// Pieces per leaf of the hierarchy.
+static const size_t CLOSEST_POINT_LEAF_SIZE = 4;
+
+// Newton steps on (c(u) - p) . c'(u) = 0 after the guess from the piece's chord.
+static const int CLOSEST_POINT_NEWTON_STEPS = 4;
+
+// Query points per task handed to the pool.
+static const size_t CLOSEST_POINT_GRAIN = 1024;
+
+// Built once from a batch of curves, read only afterwards so queries may run concurrently.
+// Each curve is cut into flat pieces by de Casteljau, the hierarchy is built over the exact boxes
+// of the pieces. A query walks the nearest boxes first, guesses u from the closest point of each
+// candidate piece's chord and refines it by Newton on the exact polynomial.
+class ClosestPointIndex {
+public:
+    // Curves stored as the engine expects them: Bezier control polygons, or p0, p1, v0, v1 for
+    // ENGINE_HERMITE, converted here to their Bezier form. Empty curves, and Hermite entries that
+    // do not hold exactly 4 points, get no pieces and are never returned.
+    ClosestPointIndex(const CurveBatch &curves, CurveEngine engine);
+
+    size_t nbPieces() const { return mPieces.size(); }
+
+    ClosestPoint closestPoint(const Vec3 &point) const;
+
+    // out[i] = closestPoint(points[i]), spread over the pool.
+    void closestPoints(const Vec3 *points, size_t count, ClosestPoint *out, ThreadPool &pool) const;
+
+    std::vector<ClosestPoint> closestPoints(const std::vector<Vec3> &points) const;
+
+private:
+    struct Piece {
+        size_t curve;
+        float u0;
+        float u1;
+        // Control polygon in mPiecePoints
+        size_t offset;
+        AABB box;
+    };
+
+    // Leaves hold mPieces[first] to mPieces[first + count - 1]. An inner node's left child follows
+    // it, its right child is at index first.
+    struct Node {
+        AABB box;
+        size_t first;
+        size_t count;
+    };
+
+    void addPieces(size_t curve, const Vec3 *points, float u0, float u1, int depth);
+
+    size_t build(size_t begin, size_t end);
+
+    // scratch holds mMaxPoints points
+    ClosestPoint query(const Vec3 &point, Vec3 *scratch) const;
+
+    void refine(const Piece &piece, const Vec3 &point, ClosestPoint &best, float &bestSquareDistance,
+                Vec3 *scratch) const;
+
+    // Bezier control polygons, curve c is mPoints[mOffsets[c]] to mPoints[mOffsets[c + 1] - 1]
+    std::vector<Vec3> mPoints;
+    std::vector<size_t> mOffsets;
+    size_t mMaxPoints;
+
+    std::vector<Vec3> mPiecePoints;
+    std::vector<Piece> mPieces;
+    std::vector<Node> mNodes;
+};
+
+#endif //MODELISATION_TP1_CLOSESTPOINT_H
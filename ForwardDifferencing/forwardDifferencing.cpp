@@ -0,0 +1,148 @@
+//
+// Tessellation of cubic segments by forward differencing.
+//
+
+#include "forwardDifferencing.h"
+#include "../Casteljau/casteljau.h"
+
+#include <algorithm>
+#include <cfloat>
+
+
+static double evaluate(const CubicPolynomial &polynomial, int j, double u) {
+    return ((polynomial.a[j] * u + polynomial.b[j]) * u + polynomial.c[j]) * u + polynomial.d[j];
+}
+
+
+CubicPolynomial HermiteCubicPolynomial(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1) {
+    CubicPolynomial polynomial;
+
+    for (int j = 0; j < 3; j++) {
+        polynomial.a[j] = 2.0 * p0[j] - 2.0 * p1[j] + v0[j] + v1[j];
+        polynomial.b[j] = -3.0 * p0[j] + 3.0 * p1[j] - 2.0 * v0[j] - v1[j];
+        polynomial.c[j] = v0[j];
+        polynomial.d[j] = p0[j];
+    }
+
+    return polynomial;
+}
+
+
+CubicPolynomial BezierCubicPolynomial(const std::vector<Vec3> &controlPoints) {
+    assert(controlPoints.size() == 4);
+
+    CubicPolynomial polynomial;
+
+    for (int j = 0; j < 3; j++) {
+        double q0 = controlPoints[0][j];
+        double q1 = controlPoints[1][j];
+        double q2 = controlPoints[2][j];
+        double q3 = controlPoints[3][j];
+
+        polynomial.a[j] = -q0 + 3.0 * q1 - 3.0 * q2 + q3;
+        polynomial.b[j] = 3.0 * q0 - 6.0 * q1 + 3.0 * q2;
+        polynomial.c[j] = -3.0 * q0 + 3.0 * q1;
+        polynomial.d[j] = q0;
+    }
+
+    return polynomial;
+}
+
+
+std::vector<Vec3> HermiteCubicCurveByForwardDifferencing(const Vec3 &p0, const Vec3 &p1,
+                                                         const Vec3 &v0, const Vec3 &v1, long nbU,
+                                                         long reseedInterval) {
+    return CubicCurveByForwardDifferencing(HermiteCubicPolynomial(p0, p1, v0, v1), nbU, reseedInterval);
+}
+
+
+std::vector<Vec3> BezierCubicCurveByForwardDifferencing(const std::vector<Vec3> &controlPoints, long nbU,
+                                                        long reseedInterval) {
+    if (controlPoints.size() != 4) {
+        return BezierCurveByCasteljau(controlPoints, nbU);
+    }
+
+    return CubicCurveByForwardDifferencing(BezierCubicPolynomial(controlPoints), nbU, reseedInterval);
+}
+
+
+std::vector<Vec3> CubicCurveByForwardDifferencing(const CubicPolynomial &polynomial, long nbU,
+                                                  long reseedInterval) {
+    std::vector<Vec3> curvePoints;
+    curvePoints.reserve(nbU);
+
+    if (reseedInterval < 1) {
+        reseedInterval = 1;
+    }
+
+    double h = 1.0 / (double) nbU;
+    double point[3];
+    double delta1[3];
+    double delta2[3];
+    double delta3[3];
+
+    for (long i = 0; i < nbU; i++) {
+        if (i % reseedInterval == 0) {
+            // Exact state at u = i h, from four consecutive samples of the polynomial
+            for (int j = 0; j < 3; j++) {
+                double f0 = evaluate(polynomial, j, i * h);
+                double f1 = evaluate(polynomial, j, (i + 1) * h);
+                double f2 = evaluate(polynomial, j, (i + 2) * h);
+                double f3 = evaluate(polynomial, j, (i + 3) * h);
+
+                point[j] = f0;
+                delta1[j] = f1 - f0;
+                delta2[j] = f2 - 2.0 * f1 + f0;
+                delta3[j] = f3 - 3.0 * f2 + 3.0 * f1 - f0;
+            }
+        } else {
+            for (int j = 0; j < 3; j++) {
+                point[j] += delta1[j];
+                delta1[j] += delta2[j];
+                delta2[j] += delta3[j];
+            }
+        }
+
+        curvePoints.push_back(Vec3(point[0], point[1], point[2]));
+    }
+
+    return curvePoints;
+}
+
+
+double ForwardDifferencingErrorBound(const CubicPolynomial &polynomial, long nbU, long reseedInterval) {
+    double h = 1.0 / (double) nbU;
+    double k = (double) std::max(1L, std::min(nbU, reseedInterval));
+    double eps = DBL_EPSILON;
+    double bound = 0;
+
+    for (int j = 0; j < 3; j++) {
+        double a = std::fabs(polynomial.a[j]);
+        double b = std::fabs(polynomial.b[j]);
+        double c = std::fabs(polynomial.c[j]);
+        double d = std::fabs(polynomial.d[j]);
+
+        // Largest magnitudes reached over [0, 1 + 3h] by the value and its three differences
+        double reach = 1.0 + 3.0 * h;
+        double pointMax = ((a * reach + b) * reach + c) * reach + d;
+        double delta1Max = a * (3.0 * h + 3.0 * h * h + h * h * h) * reach * reach + b * (2.0 * h + h * h) * reach + c * h;
+        double delta2Max = a * (6.0 * h * h + 6.0 * h * h * h) * reach + 2.0 * b * h * h;
+        double delta3Max = 6.0 * a * h * h * h;
+
+        // Seeding error: each difference comes from up to four samples, each off by a few ulps of pointMax
+        double seed = 8.0 * eps * pointMax;
+
+        // Every addition rounds once, and errors on delta_n propagate n times over k steps
+        double drift = eps * (k * pointMax
+                              + k * k / 2.0 * delta1Max
+                              + k * k * k / 6.0 * (delta2Max + delta3Max))
+                       + seed * (1.0 + k + k * k / 2.0 + k * k * k / 6.0);
+
+        // Final conversion to float
+        double rounding = 0.5 * FLT_EPSILON * pointMax;
+
+        bound = std::max(bound, 2.0 * drift + rounding);
+    }
+
+    return bound;
+}
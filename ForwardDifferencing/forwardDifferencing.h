@@ -0,0 +1,47 @@
+//
+// Tessellation of cubic segments by forward differencing: once set up, every new point
+// costs three vector additions instead of a full polynomial evaluation.
+//
+// Accumulators are kept in double and re-seeded from the exact polynomial every
+// reseedInterval samples, so rounding drift cannot build up over long runs.
+//
+
+#ifndef MODELISATION_TP1_FORWARDDIFFERENCING_H
+#define MODELISATION_TP1_FORWARDDIFFERENCING_H
+
+#include <vector>
+#include "../src/Vec3.h"
+
+static const long FORWARD_DIFFERENCING_RESEED = 1024;
+
+// Power basis of a cubic segment, P(u) = a u^3 + b u^2 + c u + d.
+struct CubicPolynomial {
+    double a[3];
+    double b[3];
+    double c[3];
+    double d[3];
+};
+
+extern CubicPolynomial HermiteCubicPolynomial(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1);
+
+// controlPoints must hold the 4 points of a cubic Bezier segment.
+extern CubicPolynomial BezierCubicPolynomial(const std::vector<Vec3> &controlPoints);
+
+// Same samples as HermiteCubicCurve, u = i / nbU for i in [0, nbU).
+extern std::vector<Vec3> HermiteCubicCurveByForwardDifferencing(const Vec3 &p0, const Vec3 &p1,
+                                                                 const Vec3 &v0, const Vec3 &v1, long nbU,
+                                                                 long reseedInterval = FORWARD_DIFFERENCING_RESEED);
+
+// Same samples as BezierCurveByCasteljau. Anything but a cubic falls back to de Casteljau.
+extern std::vector<Vec3> BezierCubicCurveByForwardDifferencing(const std::vector<Vec3> &controlPoints, long nbU,
+                                                               long reseedInterval = FORWARD_DIFFERENCING_RESEED);
+
+extern std::vector<Vec3> CubicCurveByForwardDifferencing(const CubicPolynomial &polynomial, long nbU,
+                                                         long reseedInterval = FORWARD_DIFFERENCING_RESEED);
+
+// Upper bound of the distance, per coordinate, between a forward differenced sample and
+// the exact polynomial, including the final rounding to float.
+extern double ForwardDifferencingErrorBound(const CubicPolynomial &polynomial, long nbU,
+                                            long reseedInterval = FORWARD_DIFFERENCING_RESEED);
+
+#endif //MODELISATION_TP1_FORWARDDIFFERENCING_H
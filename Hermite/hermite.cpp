@@ -4,26 +4,68 @@
 
 #include "hermite.h"
 
-std::vector<Vec3> HermiteCubicCurve(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1, const long nbU) {
-    std::vector<Vec3> curvePoints;
+template<typename T>
+std::vector<Vec3T<T> > HermiteCubicCurve(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1, const long nbU) {
+    std::vector<Vec3T<T> > curvePoints;
     curvePoints.reserve(nbU);
 
     for (int i = 0; i < nbU; i++) {
+        T u = (T) i / (T) nbU;
+
+        curvePoints.push_back(HermiteCubicPoint(p0, p1, v0, v1, u));
+    }
+
+    return curvePoints;
+}
+
+void HermiteCubicCurve(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1, const long nbU, Vec3Array &out) {
+    out.resize(nbU > 0 ? nbU : 0);
+
+    for (long i = 0; i < nbU; i++) {
         float u = (float) i / (float) nbU;
 
-        float f1 = (2 * u * u * u) - (3 * u * u) + 1;
-        float f2 = (-2 * u * u * u) + (3 * u * u);
-        float f3 = (u * u * u) - (2 * u * u) + u;
-        float f4 = (u * u * u) - (u * u);
+        out.set(i, HermiteCubicPoint(p0, p1, v0, v1, u));
+    }
+}
+
+template<typename T>
+void HermiteBasis(T u, T *f) {
+    f[0] = (2 * u * u * u) - (3 * u * u) + 1;
+    f[1] = (-2 * u * u * u) + (3 * u * u);
+    f[2] = (u * u * u) - (2 * u * u) + u;
+    f[3] = (u * u * u) - (u * u);
+}
 
-        Vec3 point;
+template<typename T>
+Vec3T<T> HermiteCubicPoint(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1,
+                           typename NonDeduced<T>::type u) {
+    T f[4];
+    HermiteBasis(u, f);
 
-        for (int j = 0; j < 3; j++) {
-            point[j] = f1 * p0[j] + f2 * p1[j] + f3 * v0[j] + f4 * v1[j];
-        }
+    Vec3T<T> point;
 
-        curvePoints.push_back(point);
+    for (int j = 0; j < 3; j++) {
+        point[j] = f[0] * p0[j] + f[1] * p1[j] + f[2] * v0[j] + f[3] * v1[j];
     }
 
-    return curvePoints;
+    return point;
 }
+
+template<typename T>
+void HermiteToBezier(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1, Vec3T<T> *bezier) {
+    bezier[0] = p0;
+    bezier[1] = p0 + v0 / 3;
+    bezier[2] = p1 - v1 / 3;
+    bezier[3] = p1;
+}
+
+#define INSTANTIATE_HERMITE(T) \
+    template std::vector<Vec3T<T> > HermiteCubicCurve<T>(const Vec3T<T> &, const Vec3T<T> &, \
+                                                         const Vec3T<T> &, const Vec3T<T> &, long); \
+    template void HermiteBasis<T>(T, T *); \
+    template Vec3T<T> HermiteCubicPoint<T>(const Vec3T<T> &, const Vec3T<T> &, const Vec3T<T> &, const Vec3T<T> &, T); \
+    template void HermiteToBezier<T>(const Vec3T<T> &, const Vec3T<T> &, const Vec3T<T> &, const Vec3T<T> &, Vec3T<T> *);
+
+INSTANTIATE_HERMITE(float)
+INSTANTIATE_HERMITE(double)
+INSTANTIATE_HERMITE(long double)
@@ -7,7 +7,26 @@
 
 #include <vector>
 #include "../src/Vec3.h"
+#include "../Simd/vec3Array.h"
 
-extern std::vector<Vec3> HermiteCubicCurve(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1, const long nbU);
+// Instantiated for float, double and long double in hermite.cpp.
+
+template<typename T>
+std::vector<Vec3T<T> > HermiteCubicCurve(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1, const long nbU);
+
+// The same points in float, written straight into out's lanes, resized to nbU points.
+extern void HermiteCubicCurve(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1, long nbU, Vec3Array &out);
+
+// f[0..3], the weights of p0, p1, v0 and v1 at u.
+template<typename T>
+void HermiteBasis(T u, T *f);
+
+template<typename T>
+Vec3T<T> HermiteCubicPoint(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1,
+                           typename NonDeduced<T>::type u);
+
+// The same cubic as a Bezier curve: bezier[0..3] = p0, p0 + v0 / 3, p1 - v1 / 3, p1.
+template<typename T>
+void HermiteToBezier(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &v0, const Vec3T<T> &v1, Vec3T<T> *bezier);
 
 #endif //MODELISATION_TP1_HERMITE_H
@@ -0,0 +1,142 @@
+//
+// Piecewise cubic Hermite splines through a sequence of keys, tangents computed automatically.
+//
+
+#include "hermiteSpline.h"
+#include "hermite.h"
+
+#include <cmath>
+
+template<typename T>
+static Vec3T<T> keyAt(const std::vector<Vec3T<T> > &keys, long i) {
+    long last = (long) keys.size() - 1;
+
+    if (i < 0) {
+        return 2 * keys[0] - keys[1];
+    }
+
+    if (i > last) {
+        return 2 * keys[last] - keys[last - 1];
+    }
+
+    return keys[i];
+}
+
+// Knot spacing |b - a|^alpha, never 0 so coincident keys do not divide by zero
+template<typename T>
+static T knotSpacing(const Vec3T<T> &a, const Vec3T<T> &b, T alpha) {
+    T spacing = std::pow((b - a).length(), alpha);
+
+    return spacing > 0 ? spacing : (T) 1;
+}
+
+// Tangent at p1 of the non uniform Catmull-Rom through p0, p1, p2 with knot spacings d0 = t1 - t0
+// and d1 = t2 - t1, in units of the parameter, i.e. still to be scaled by the segment's spacing.
+template<typename T>
+static Vec3T<T> catmullRomDerivative(const Vec3T<T> &p0, const Vec3T<T> &p1, const Vec3T<T> &p2, T d0, T d1) {
+    return (p1 - p0) / d0 - (p2 - p0) / (d0 + d1) + (p2 - p1) / d1;
+}
+
+template<typename T>
+HermiteSplineT<T>::HermiteSplineT(const std::vector<Vec3T<T> > &keys, SplineTangents tangents, SplineShape shape)
+        : mKeys(keys) {
+    size_t nbSegments = this->nbSegments();
+
+    mStartTangents.resize(nbSegments);
+    mEndTangents.resize(nbSegments);
+
+    if (nbSegments == 0) {
+        return;
+    }
+
+    if (tangents == TANGENTS_CATMULL_ROM || tangents == TANGENTS_CENTRIPETAL || tangents == TANGENTS_CHORDAL) {
+        T alpha = tangents == TANGENTS_CATMULL_ROM ? 0 : tangents == TANGENTS_CENTRIPETAL ? 0.5 : 1;
+
+        for (long s = 0; s < (long) nbSegments; s++) {
+            Vec3T<T> p0 = keyAt(mKeys, s - 1);
+            Vec3T<T> p1 = keyAt(mKeys, s);
+            Vec3T<T> p2 = keyAt(mKeys, s + 1);
+            Vec3T<T> p3 = keyAt(mKeys, s + 2);
+
+            T d0 = knotSpacing(p0, p1, alpha);
+            T d1 = knotSpacing(p1, p2, alpha);
+            T d2 = knotSpacing(p2, p3, alpha);
+
+            mStartTangents[s] = d1 * catmullRomDerivative(p0, p1, p2, d0, d1);
+            mEndTangents[s] = d1 * catmullRomDerivative(p1, p2, p3, d1, d2);
+        }
+
+        return;
+    }
+
+    T tension = shape.tension;
+    T continuity = tangents == TANGENTS_CARDINAL ? 0 : shape.continuity;
+    T bias = tangents == TANGENTS_CARDINAL ? 0 : shape.bias;
+
+    // Incoming and outgoing tangents at every key
+    for (long i = 0; i < (long) mKeys.size(); i++) {
+        Vec3T<T> before = keyAt(mKeys, i) - keyAt(mKeys, i - 1);
+        Vec3T<T> after = keyAt(mKeys, i + 1) - keyAt(mKeys, i);
+
+        Vec3T<T> outgoing = ((1 - tension) * (1 + bias) * (1 + continuity) / 2) * before
+                            + ((1 - tension) * (1 - bias) * (1 - continuity) / 2) * after;
+        Vec3T<T> incoming = ((1 - tension) * (1 + bias) * (1 - continuity) / 2) * before
+                            + ((1 - tension) * (1 - bias) * (1 + continuity) / 2) * after;
+
+        if (i < (long) nbSegments) {
+            mStartTangents[i] = outgoing;
+        }
+
+        if (i > 0) {
+            mEndTangents[i - 1] = incoming;
+        }
+    }
+}
+
+template<typename T>
+Vec3T<T> HermiteSplineT<T>::point(size_t segment, T u) const {
+    return HermiteCubicPoint(mKeys[segment], mKeys[segment + 1], mStartTangents[segment], mEndTangents[segment], u);
+}
+
+template<typename T>
+std::vector<Vec3T<T> > HermiteSplineT<T>::curve(long nbU) const {
+    std::vector<Vec3T<T> > curvePoints;
+    size_t nbSegments = this->nbSegments();
+
+    if (nbSegments == 0) {
+        return mKeys;
+    }
+
+    std::vector<T> weights(4 * nbU);
+
+    for (long i = 0; i < nbU; i++) {
+        HermiteBasis((T) i / (T) nbU, &weights[4 * i]);
+    }
+
+    curvePoints.resize(nbSegments * nbU + 1);
+
+    for (size_t s = 0; s < nbSegments; s++) {
+        const Vec3T<T> &p0 = mKeys[s];
+        const Vec3T<T> &p1 = mKeys[s + 1];
+        const Vec3T<T> &v0 = mStartTangents[s];
+        const Vec3T<T> &v1 = mEndTangents[s];
+
+        Vec3T<T> *out = &curvePoints[s * nbU];
+
+        for (long i = 0; i < nbU; i++) {
+            const T *f = &weights[4 * i];
+
+            for (int j = 0; j < 3; j++) {
+                out[i][j] = f[0] * p0[j] + f[1] * p1[j] + f[2] * v0[j] + f[3] * v1[j];
+            }
+        }
+    }
+
+    curvePoints.back() = mKeys.back();
+
+    return curvePoints;
+}
+
+template class HermiteSplineT<float>;
+template class HermiteSplineT<double>;
+template class HermiteSplineT<long double>;
@@ -0,0 +1,63 @@
+//
+// Piecewise cubic Hermite splines through a sequence of keys, tangents computed automatically.
+//
+
+#ifndef MODELISATION_TP1_HERMITESPLINE_H
+#define MODELISATION_TP1_HERMITESPLINE_H
+
+#include <vector>
+#include "../src/Vec3.h"
+
+enum SplineTangents {
+    // (P_(i+1) - P_(i-1)) / 2
+    TANGENTS_CATMULL_ROM,
+    // Non uniform Catmull-Rom, knots spaced by |P_(i+1) - P_i|^0.5: no cusps nor self intersections within a segment
+    TANGENTS_CENTRIPETAL,
+    // Non uniform Catmull-Rom, knots spaced by |P_(i+1) - P_i|
+    TANGENTS_CHORDAL,
+    // (1 - tension) (P_(i+1) - P_(i-1)) / 2
+    TANGENTS_CARDINAL,
+    // Kochanek-Bartels, tension / continuity / bias, separate incoming and outgoing tangents
+    TANGENTS_KOCHANEK_BARTELS
+};
+
+struct SplineShape {
+    float tension;
+    float continuity;
+    float bias;
+
+    SplineShape(float tension = 0, float continuity = 0, float bias = 0)
+            : tension(tension), continuity(continuity), bias(bias) {}
+};
+
+// Segment s goes from keys[s] to keys[s + 1] as a HermiteCubicCurve. End keys get tangents
+// from phantom keys mirrored through them, 2 P_0 - P_1 and 2 P_(n-1) - P_(n-2).
+template<typename T>
+class HermiteSplineT {
+public:
+    HermiteSplineT(const std::vector<Vec3T<T> > &keys, SplineTangents tangents, SplineShape shape = SplineShape());
+
+    size_t nbSegments() const { return mKeys.size() < 2 ? 0 : mKeys.size() - 1; }
+
+    const std::vector<Vec3T<T> > &keys() const { return mKeys; }
+
+    // Tangents of segment s at keys[s] and keys[s + 1], scaled for u in [0, 1].
+    const Vec3T<T> &startTangent(size_t segment) const { return mStartTangents[segment]; }
+
+    const Vec3T<T> &endTangent(size_t segment) const { return mEndTangents[segment]; }
+
+    Vec3T<T> point(size_t segment, T u) const;
+
+    // nbU points per segment at u = i / nbU, every segment back to back, then the last key.
+    // The Hermite weights of each u are computed once and shared by all the segments.
+    std::vector<Vec3T<T> > curve(long nbU) const;
+
+private:
+    std::vector<Vec3T<T> > mKeys;
+    std::vector<Vec3T<T> > mStartTangents;
+    std::vector<Vec3T<T> > mEndTangents;
+};
+
+typedef HermiteSplineT<float> HermiteSpline;
+
+#endif //MODELISATION_TP1_HERMITESPLINE_H
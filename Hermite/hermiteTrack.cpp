@@ -0,0 +1,121 @@
+//
+// Animation track: values keyed by time, cubic Hermite between keys.
+//
+
+#include "hermiteTrack.h"
+#include "hermite.h"
+
+#include <algorithm>
+
+template<typename T>
+HermiteTrackT<T>::HermiteTrackT(const std::vector<T> &times, const std::vector<Vec3T<T> > &values)
+        : mTimes(times), mValues(values), mTangents(values.size()), mCursor(0) {
+    assert(times.size() == values.size());
+
+    size_t n = values.size();
+
+    for (size_t i = 0; i < n; i++) {
+        if (n < 2) {
+            mTangents[i] = Vec3T<T>(0, 0, 0);
+        } else if (i == 0) {
+            mTangents[i] = (values[1] - values[0]) / (times[1] - times[0]);
+        } else if (i == n - 1) {
+            mTangents[i] = (values[i] - values[i - 1]) / (times[i] - times[i - 1]);
+        } else {
+            // Non uniform Catmull-Rom on the key times
+            T before = times[i] - times[i - 1];
+            T after = times[i + 1] - times[i];
+
+            mTangents[i] = (values[i] - values[i - 1]) / before
+                           - (values[i + 1] - values[i - 1]) / (before + after)
+                           + (values[i + 1] - values[i]) / after;
+        }
+    }
+}
+
+template<typename T>
+HermiteTrackT<T>::HermiteTrackT(const std::vector<T> &times, const std::vector<Vec3T<T> > &values,
+                                const std::vector<Vec3T<T> > &tangents)
+        : mTimes(times), mValues(values), mTangents(tangents), mCursor(0) {
+    assert(times.size() == values.size() && values.size() == tangents.size());
+}
+
+template<typename T>
+size_t HermiteTrackT<T>::findSegment(T time) const {
+    if (mTimes.size() < 2) {
+        return 0;
+    }
+
+    typename std::vector<T>::const_iterator after = std::upper_bound(mTimes.begin(), mTimes.end(), time);
+    size_t segment = after == mTimes.begin() ? 0 : (size_t) (after - mTimes.begin()) - 1;
+
+    return std::min(segment, mTimes.size() - 2);
+}
+
+template<typename T>
+Vec3T<T> HermiteTrackT<T>::evaluate(size_t segment, T time) const {
+    if (mValues.empty()) {
+        return Vec3T<T>(0, 0, 0);
+    }
+
+    if (mValues.size() == 1 || time <= mTimes.front()) {
+        return mValues.front();
+    }
+
+    if (time >= mTimes.back()) {
+        return mValues.back();
+    }
+
+    T duration = mTimes[segment + 1] - mTimes[segment];
+    T u = (time - mTimes[segment]) / duration;
+
+    // Time derivatives scaled to the segment's unit parameter
+    return HermiteCubicPoint(mValues[segment], mValues[segment + 1],
+                             duration * mTangents[segment], duration * mTangents[segment + 1], u);
+}
+
+template<typename T>
+Vec3T<T> HermiteTrackT<T>::sampleAt(T time) const {
+    return evaluate(findSegment(time), time);
+}
+
+template<typename T>
+Vec3T<T> HermiteTrackT<T>::sample(T time) {
+    size_t nbSegments = mTimes.size() < 2 ? 0 : mTimes.size() - 1;
+
+    if (nbSegments > 0) {
+        if (mCursor >= nbSegments) {
+            mCursor = nbSegments - 1;
+        }
+
+        if (time >= mTimes[mCursor] && time < mTimes[mCursor + 1]) {
+            // Still in the same segment
+        } else if (mCursor + 1 < nbSegments && time >= mTimes[mCursor + 1] && time < mTimes[mCursor + 2]) {
+            mCursor++;
+        } else {
+            mCursor = findSegment(time);
+        }
+    }
+
+    return evaluate(mCursor, time);
+}
+
+template<typename T>
+void HermiteTrackT<T>::sample(const T *times, size_t count, Vec3T<T> *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = sample(times[i]);
+    }
+}
+
+template<typename T>
+std::vector<Vec3T<T> > HermiteTrackT<T>::sample(const std::vector<T> &times) {
+    std::vector<Vec3T<T> > values(times.size());
+
+    sample(times.data(), times.size(), values.data());
+
+    return values;
+}
+
+template class HermiteTrackT<float>;
+template class HermiteTrackT<double>;
+template class HermiteTrackT<long double>;
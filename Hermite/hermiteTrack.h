@@ -0,0 +1,54 @@
+//
+// Animation track: values keyed by time, cubic Hermite between keys.
+//
+
+#ifndef MODELISATION_TP1_HERMITETRACK_H
+#define MODELISATION_TP1_HERMITETRACK_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+
+// Keys must have strictly increasing times. Before the first key and after the last one
+// the track holds the end values.
+template<typename T>
+class HermiteTrackT {
+public:
+    // Tangents (derivatives with respect to time) from a Catmull-Rom on the key times.
+    HermiteTrackT(const std::vector<T> &times, const std::vector<Vec3T<T> > &values);
+
+    // Explicit tangents, derivatives with respect to time.
+    HermiteTrackT(const std::vector<T> &times, const std::vector<Vec3T<T> > &values,
+                  const std::vector<Vec3T<T> > &tangents);
+
+    size_t nbKeys() const { return mTimes.size(); }
+
+    // Random access, O(log n) binary search, leaves the cursor alone.
+    Vec3T<T> sampleAt(T time) const;
+
+    // Sequential access: checks the cursor's segment and the next one first, so monotonic
+    // playback is O(1) per query, and falls back to a binary search on jumps.
+    Vec3T<T> sample(T time);
+
+    // out[i] = sample(times[i]), through the cursor.
+    void sample(const T *times, size_t count, Vec3T<T> *out);
+
+    std::vector<Vec3T<T> > sample(const std::vector<T> &times);
+
+    void resetCursor() { mCursor = 0; }
+
+    // Segment s such that times[s] <= time < times[s + 1], clamped to [0, nbKeys - 2].
+    size_t findSegment(T time) const;
+
+private:
+    Vec3T<T> evaluate(size_t segment, T time) const;
+
+    std::vector<T> mTimes;
+    std::vector<Vec3T<T> > mValues;
+    std::vector<Vec3T<T> > mTangents;
+    size_t mCursor;
+};
+
+typedef HermiteTrackT<float> HermiteTrack;
+
+#endif //MODELISATION_TP1_HERMITETRACK_H
@@ -0,0 +1,437 @@
+//
+// Curve-curve and self intersections of Bezier curves, by subdivision with bounding box rejection.
+//
+
+#include "intersection.h"
+#include "../Casteljau/casteljau.h"
+#include "../Bounds/bounds.h"
+
+#include <algorithm>
+
+template<typename T>
+struct BezierPiece {
+    const Vec3T<T> *points;
+    T u0;
+    T u1;
+};
+
+template<typename T>
+struct IntersectionSearch {
+    const std::vector<Vec3T<T> > *curveA;
+    const std::vector<Vec3T<T> > *curveB;
+    T tolerance;
+    // buffers[depth] holds 3 polygons: scratch, left half, right half
+    std::vector<std::vector<Vec3T<T> > > buffers;
+    CasteljauWorkspaceT<T> workspace;
+    std::vector<CurveIntersectionT<T> > hits;
+    // Distance between both curve points of each hit
+    std::vector<T> gaps;
+};
+
+template<typename T>
+static T clamp01(T x) {
+    return std::max((T) 0, std::min((T) 1, x));
+}
+
+// s and t of the closest points p1 + s (q1 - p1) and p2 + t (q2 - p2) of two segments
+template<typename T>
+static void closestPointsOfSegments(const Vec3T<T> &p1, const Vec3T<T> &q1, const Vec3T<T> &p2, const Vec3T<T> &q2,
+                                    T &s, T &t) {
+    Vec3T<T> d1 = q1 - p1;
+    Vec3T<T> d2 = q2 - p2;
+    Vec3T<T> r = p1 - p2;
+    T a = Vec3T<T>::dot(d1, d1);
+    T e = Vec3T<T>::dot(d2, d2);
+    T f = Vec3T<T>::dot(d2, r);
+
+    if (a == 0 && e == 0) {
+        s = 0;
+        t = 0;
+        return;
+    }
+
+    if (a == 0) {
+        s = 0;
+        t = clamp01(f / e);
+        return;
+    }
+
+    T c = Vec3T<T>::dot(d1, r);
+
+    if (e == 0) {
+        t = 0;
+        s = clamp01(-c / a);
+        return;
+    }
+
+    T b = Vec3T<T>::dot(d1, d2);
+    T denominator = a * e - b * b;
+
+    // Parallel chords: any s works, start from the first end
+    s = denominator != 0 ? clamp01((b * f - c * e) / denominator) : 0;
+    t = (b * s + f) / e;
+
+    if (t < 0) {
+        t = 0;
+        s = clamp01(-c / a);
+    } else if (t > 1) {
+        t = 1;
+        s = clamp01((b - c) / a);
+    }
+}
+
+template<typename T>
+static T distanceToSegment(const Vec3T<T> &p, const Vec3T<T> &a, const Vec3T<T> &b) {
+    Vec3T<T> ab = b - a;
+    Vec3T<T> ap = p - a;
+    T squareLength = ab.squareLength();
+
+    if (squareLength == 0) {
+        return ap.length();
+    }
+
+    T t = clamp01(Vec3T<T>::dot(ap, ab) / squareLength);
+
+    return (ap - t * ab).length();
+}
+
+template<typename T>
+static bool isFlat(const Vec3T<T> *points, size_t count, T tolerance) {
+    for (size_t i = 1; i + 1 < count; i++) {
+        if (distanceToSegment(points[i], points[0], points[count - 1]) > tolerance) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Every leg of the polygon moves forward along direction, so the curve never comes back on itself
+template<typename T>
+static bool advancesAlong(const Vec3T<T> *points, size_t count, const Vec3T<T> &direction) {
+    for (size_t i = 0; i + 1 < count; i++) {
+        if (Vec3T<T>::dot(points[i + 1] - points[i], direction) <= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+static Vec3T<T> *splitInHalves(IntersectionSearch<T> &search, int depth, const Vec3T<T> *points, size_t count) {
+    if (search.buffers.size() <= (size_t) depth) {
+        search.buffers.resize(depth + 1);
+    }
+
+    std::vector<Vec3T<T> > &buffer = search.buffers[depth];
+    buffer.resize(3 * count);
+
+    Vec3T<T> *scratch = buffer.data();
+    std::copy(points, points + count, scratch);
+    CasteljauSplit(scratch, count, (T) 0.5, scratch + count, scratch + 2 * count);
+
+    // Left half, the right one follows
+    return scratch + count;
+}
+
+template<typename T>
+static void resolve(IntersectionSearch<T> &search, const BezierPiece<T> &a, const BezierPiece<T> &b) {
+    size_t nbA = search.curveA->size();
+    size_t nbB = search.curveB->size();
+    T s, t;
+
+    closestPointsOfSegments(a.points[0], a.points[nbA - 1], b.points[0], b.points[nbB - 1], s, t);
+
+    T uA = a.u0 + s * (a.u1 - a.u0);
+    T uB = b.u0 + t * (b.u1 - b.u0);
+    Vec3T<T> pointA = BezierPointByCasteljau(*search.curveA, uA, search.workspace);
+    Vec3T<T> pointB = BezierPointByCasteljau(*search.curveB, uB, search.workspace);
+    T gap = (pointA - pointB).length();
+
+    if (gap <= search.tolerance) {
+        CurveIntersectionT<T> hit;
+        hit.curveA = 0;
+        hit.curveB = 1;
+        hit.uA = uA;
+        hit.uB = uB;
+        hit.point = (T) 0.5 * (pointA + pointB);
+
+        search.hits.push_back(hit);
+        search.gaps.push_back(gap);
+    }
+}
+
+// adjacent: a ends where b starts on the same curve, that shared point is not an intersection
+template<typename T>
+static void intersect(IntersectionSearch<T> &search, const BezierPiece<T> &a, const BezierPiece<T> &b,
+                      int depth, bool adjacent) {
+    size_t nbA = search.curveA->size();
+    size_t nbB = search.curveB->size();
+
+    AABBT<T> boxA = AABBT<T>::ofPoints(a.points, nbA);
+    AABBT<T> boxB = AABBT<T>::ofPoints(b.points, nbB);
+
+    if (!boxA.overlaps(boxB, search.tolerance)) {
+        return;
+    }
+
+    if (adjacent) {
+        Vec3T<T> direction = b.points[nbB - 1] - a.points[0];
+
+        if (advancesAlong(a.points, nbA, direction) && advancesAlong(b.points, nbB, direction)) {
+            return;
+        }
+    }
+
+    bool flatA = isFlat(a.points, nbA, search.tolerance / 2);
+    bool flatB = isFlat(b.points, nbB, search.tolerance / 2);
+
+    if ((flatA && flatB) || depth >= INTERSECTION_MAX_DEPTH) {
+        if (!adjacent) {
+            resolve(search, a, b);
+        }
+
+        return;
+    }
+
+    T middle;
+
+    if (!flatA && (flatB || boxA.diagonal() >= boxB.diagonal())) {
+        Vec3T<T> *left = splitInHalves(search, depth, a.points, nbA);
+        middle = (a.u0 + a.u1) / 2;
+
+        BezierPiece<T> leftPiece = {left, a.u0, middle};
+        BezierPiece<T> rightPiece = {left + nbA, middle, a.u1};
+
+        intersect(search, leftPiece, b, depth + 1, false);
+        intersect(search, rightPiece, b, depth + 1, adjacent);
+    } else {
+        Vec3T<T> *left = splitInHalves(search, depth, b.points, nbB);
+        middle = (b.u0 + b.u1) / 2;
+
+        BezierPiece<T> leftPiece = {left, b.u0, middle};
+        BezierPiece<T> rightPiece = {left + nbB, middle, b.u1};
+
+        intersect(search, a, leftPiece, depth + 1, adjacent);
+        intersect(search, a, rightPiece, depth + 1, false);
+    }
+}
+
+template<typename T>
+static void intersectSelf(IntersectionSearch<T> &search, const BezierPiece<T> &piece, int depth) {
+    size_t count = search.curveA->size();
+
+    // A piece flat within tolerance can only fold back onto itself, as at a cusp, which is not reported
+    if (depth >= INTERSECTION_MAX_DEPTH
+        || advancesAlong(piece.points, count, piece.points[count - 1] - piece.points[0])
+        || isFlat(piece.points, count, search.tolerance / 2)) {
+        return;
+    }
+
+    Vec3T<T> *left = splitInHalves(search, depth, piece.points, count);
+    T middle = (piece.u0 + piece.u1) / 2;
+
+    BezierPiece<T> leftPiece = {left, piece.u0, middle};
+    BezierPiece<T> rightPiece = {left + count, middle, piece.u1};
+
+    intersectSelf(search, leftPiece, depth + 1);
+    intersectSelf(search, rightPiece, depth + 1);
+    intersect(search, leftPiece, rightPiece, depth + 1, true);
+}
+
+template<typename T>
+static bool byParameterA(const std::pair<CurveIntersectionT<T>, T> &first, const std::pair<CurveIntersectionT<T>, T> &second) {
+    return first.first.uA < second.first.uA;
+}
+
+// Both hits belong to one crossing or one contact: close together, or the curves still within
+// tolerance halfway between them
+template<typename T>
+static bool sameContact(IntersectionSearch<T> &search, const CurveIntersectionT<T> &first,
+                        const CurveIntersectionT<T> &second) {
+    if ((first.point - second.point).length() <= 2 * search.tolerance) {
+        return true;
+    }
+
+    Vec3T<T> pointA = BezierPointByCasteljau(*search.curveA, (first.uA + second.uA) / 2, search.workspace);
+    Vec3T<T> pointB = BezierPointByCasteljau(*search.curveB, (first.uB + second.uB) / 2, search.workspace);
+
+    return (pointA - pointB).length() <= search.tolerance;
+}
+
+// Neighbouring pieces report the same crossing, keep the tightest hit of each cluster
+template<typename T>
+static std::vector<CurveIntersectionT<T> > mergedHits(IntersectionSearch<T> &search) {
+    std::vector<std::pair<CurveIntersectionT<T>, T> > hits;
+
+    for (size_t i = 0; i < search.hits.size(); i++) {
+        hits.push_back(std::make_pair(search.hits[i], search.gaps[i]));
+    }
+
+    std::sort(hits.begin(), hits.end(), byParameterA<T>);
+
+    std::vector<CurveIntersectionT<T> > merged;
+    T bestGap = 0;
+
+    for (size_t i = 0; i < hits.size(); i++) {
+        bool sameCluster = i > 0 && sameContact(search, hits[i - 1].first, hits[i].first);
+
+        if (!sameCluster) {
+            merged.push_back(hits[i].first);
+            bestGap = hits[i].second;
+        } else if (hits[i].second < bestGap) {
+            merged.back() = hits[i].first;
+            bestGap = hits[i].second;
+        }
+    }
+
+    return merged;
+}
+
+template<typename T>
+std::vector<CurveIntersectionT<T> > BezierIntersections(const std::vector<Vec3T<T> > &a,
+                                                        const std::vector<Vec3T<T> > &b,
+                                                        const typename NonDeduced<T>::type tolerance) {
+    if (a.empty() || b.empty()) {
+        return std::vector<CurveIntersectionT<T> >();
+    }
+
+    IntersectionSearch<T> search;
+    search.curveA = &a;
+    search.curveB = &b;
+    search.tolerance = tolerance;
+
+    BezierPiece<T> pieceA = {a.data(), 0, 1};
+    BezierPiece<T> pieceB = {b.data(), 0, 1};
+
+    intersect(search, pieceA, pieceB, 0, false);
+
+    return mergedHits(search);
+}
+
+template<typename T>
+std::vector<CurveIntersectionT<T> > BezierSelfIntersections(const std::vector<Vec3T<T> > &curve,
+                                                            const typename NonDeduced<T>::type tolerance) {
+    if (curve.size() < 3) {
+        return std::vector<CurveIntersectionT<T> >();
+    }
+
+    IntersectionSearch<T> search;
+    search.curveA = &curve;
+    search.curveB = &curve;
+    search.tolerance = tolerance;
+
+    BezierPiece<T> piece = {curve.data(), 0, 1};
+
+    intersectSelf(search, piece, 0);
+
+    std::vector<CurveIntersectionT<T> > hits = mergedHits(search);
+
+    for (size_t i = 0; i < hits.size(); i++) {
+        hits[i].curveB = 0;
+    }
+
+    return hits;
+}
+
+template<typename T>
+std::vector<std::pair<size_t, size_t> > OverlappingBoxPairs(const std::vector<AABBT<T> > &boxes) {
+    std::vector<std::pair<size_t, size_t> > pairs;
+    std::vector<size_t> order;
+    AABBT<T> centers;
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+        if (!boxes[i].empty()) {
+            order.push_back(i);
+            centers.extend(boxes[i].center());
+        }
+    }
+
+    if (order.size() < 2) {
+        return pairs;
+    }
+
+    Vec3T<T> spread = centers.extent();
+    unsigned int axis = spread[0] >= spread[1] ? (spread[0] >= spread[2] ? 0 : 2) : (spread[1] >= spread[2] ? 1 : 2);
+
+    std::sort(order.begin(), order.end(), [&boxes, axis](size_t i, size_t j) {
+        return boxes[i].min[axis] < boxes[j].min[axis];
+    });
+
+    std::vector<size_t> open;
+
+    for (size_t k = 0; k < order.size(); k++) {
+        const AABBT<T> &box = boxes[order[k]];
+
+        // Boxes sorted by start: one ending before this start ends before every later one too
+        open.erase(std::remove_if(open.begin(), open.end(), [&boxes, &box, axis](size_t i) {
+            return boxes[i].max[axis] < box.min[axis];
+        }), open.end());
+
+        for (size_t i = 0; i < open.size(); i++) {
+            if (boxes[open[i]].overlaps(box)) {
+                pairs.push_back(std::make_pair(std::min(open[i], order[k]), std::max(open[i], order[k])));
+            }
+        }
+
+        open.push_back(order[k]);
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    return pairs;
+}
+
+template<typename T>
+std::vector<CurveIntersectionT<T> > BezierIntersections(const std::vector<std::vector<Vec3T<T> > > &curves,
+                                                        const typename NonDeduced<T>::type tolerance) {
+    std::vector<AABBT<T> > boxes(curves.size());
+
+    for (size_t i = 0; i < curves.size(); i++) {
+        boxes[i] = BezierBounds(curves[i]);
+
+        // Boxes overlap when their curves come closer than tolerance
+        if (!boxes[i].empty()) {
+            boxes[i].inflate(tolerance / 2);
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t> > pairs = OverlappingBoxPairs(boxes);
+    std::vector<CurveIntersectionT<T> > intersections;
+    size_t next = 0;
+
+    // Pairs come sorted, so curve i's self intersections go before its pairs with later curves
+    for (size_t i = 0; i < curves.size(); i++) {
+        std::vector<CurveIntersectionT<T> > hits = BezierSelfIntersections(curves[i], tolerance);
+
+        for (size_t h = 0; h < hits.size(); h++) {
+            hits[h].curveA = i;
+            hits[h].curveB = i;
+            intersections.push_back(hits[h]);
+        }
+
+        for (; next < pairs.size() && pairs[next].first == i; next++) {
+            hits = BezierIntersections(curves[i], curves[pairs[next].second], tolerance);
+
+            for (size_t h = 0; h < hits.size(); h++) {
+                hits[h].curveA = i;
+                hits[h].curveB = pairs[next].second;
+                intersections.push_back(hits[h]);
+            }
+        }
+    }
+
+    return intersections;
+}
+
+#define INSTANTIATE_INTERSECTION(T) \
+    template std::vector<CurveIntersectionT<T> > BezierIntersections<T>(const std::vector<Vec3T<T> > &, \
+                                                                         const std::vector<Vec3T<T> > &, T); \
+    template std::vector<CurveIntersectionT<T> > BezierSelfIntersections<T>(const std::vector<Vec3T<T> > &, T); \
+    template std::vector<std::pair<size_t, size_t> > OverlappingBoxPairs<T>(const std::vector<AABBT<T> > &); \
+    template std::vector<CurveIntersectionT<T> > BezierIntersections<T>(const std::vector<std::vector<Vec3T<T> > > &, T);
+
+INSTANTIATE_INTERSECTION(float)
+INSTANTIATE_INTERSECTION(double)
+INSTANTIATE_INTERSECTION(long double)
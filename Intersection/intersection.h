@@ -0,0 +1,59 @@
+//
+// Curve-curve and self intersections of Bezier curves, by subdivision with bounding box rejection.
+//
+
+#ifndef MODELISATION_TP1_INTERSECTION_H
+#define MODELISATION_TP1_INTERSECTION_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "../src/Vec3.h"
+#include "../src/AABB.h"
+
+// Everything here is instantiated for float, double and long double in intersection.cpp.
+
+// Curves meet at point, at uA on curveA and uB on curveB, within the tolerance.
+// curveA == curveB for a self intersection, then uA < uB.
+template<typename T>
+struct CurveIntersectionT {
+    size_t curveA;
+    size_t curveB;
+    T uA;
+    T uB;
+    Vec3T<T> point;
+};
+
+typedef CurveIntersectionT<float> CurveIntersection;
+
+// Total number of halvings of both curves past which a pair of pieces is resolved whatever its size.
+static const int INTERSECTION_MAX_DEPTH = 48;
+
+// Points where two curves come closer than tolerance, curveA = 0 and curveB = 1.
+// Pieces are halved by de Casteljau until their control polygon boxes stop overlapping, or both
+// are flat within tolerance / 2 and the closest points of their chords give the intersection.
+// Hits of one crossing, or of one stretch where the curves run within tolerance, are merged into one.
+template<typename T>
+std::vector<CurveIntersectionT<T> > BezierIntersections(const std::vector<Vec3T<T> > &a,
+                                                        const std::vector<Vec3T<T> > &b,
+                                                        typename NonDeduced<T>::type tolerance);
+
+// Points where a curve comes back closer than tolerance to itself, curveA = curveB = 0.
+// A piece whose control polygon advances along its chord at every leg cannot cross itself and is
+// dropped, others are halved and both halves are intersected with each other.
+template<typename T>
+std::vector<CurveIntersectionT<T> > BezierSelfIntersections(const std::vector<Vec3T<T> > &curve,
+                                                            typename NonDeduced<T>::type tolerance);
+
+// Broad phase: every pair i < j of overlapping boxes, by sorting on the axis where the box centers
+// spread the most and sweeping a list of the boxes still open.
+template<typename T>
+std::vector<std::pair<size_t, size_t> > OverlappingBoxPairs(const std::vector<AABBT<T> > &boxes);
+
+// Every intersection and self intersection in a set of curves. Candidate pairs come from the broad
+// phase over the curves' exact boxes inflated by tolerance.
+template<typename T>
+std::vector<CurveIntersectionT<T> > BezierIntersections(const std::vector<std::vector<Vec3T<T> > > &curves,
+                                                        typename NonDeduced<T>::type tolerance);
+
+#endif //MODELISATION_TP1_INTERSECTION_H
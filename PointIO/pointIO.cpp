@@ -0,0 +1,106 @@
+//
+// Bulk binary I/O of point sets: files hold the raw Vec3 scalars, read and written in one call.
+//
+
+#include <cstdio>
+#include "pointIO.h"
+
+namespace {
+
+// Element is trivially copyable, so the file bytes go straight into the vector storage.
+template<typename Element>
+bool readRecords(const char *path, std::vector<Element> &records) {
+    records.clear();
+
+    FILE *file = std::fopen(path, "rb");
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    bool ok = std::fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(file) : -1;
+    ok = size >= 0 && size % (long) sizeof(Element) == 0 && std::fseek(file, 0, SEEK_SET) == 0;
+
+    if (ok) {
+        records.resize((size_t) size / sizeof(Element));
+        ok = std::fread(records.data(), sizeof(Element), records.size(), file) == records.size();
+    }
+
+    std::fclose(file);
+
+    if (!ok) {
+        records.clear();
+    }
+
+    return ok;
+}
+
+template<typename Element>
+bool writeRecords(const char *path, const Element *records, size_t count) {
+    FILE *file = std::fopen(path, "wb");
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    bool ok = std::fwrite(records, sizeof(Element), count, file) == count;
+
+    return std::fclose(file) == 0 && ok;
+}
+
+// Files hold exactly 3 scalars per point, no byte of the record may be padding. long double is
+// 10 bytes of value stored in 12 or 16 on x86, so it is left out.
+template<typename T>
+struct PackedScalar {
+    static const bool value = (std::is_same<T, float>::value || std::is_same<T, double>::value)
+                              && sizeof(Vec3T<T>) == 3 * sizeof(T);
+};
+
+}
+
+template<typename T>
+bool ReadVec3Binary(const char *path, std::vector<Vec3T<T> > &points) {
+    static_assert(PackedScalar<T>::value, "Vec3T<T> records must be 3 scalars without padding");
+
+    return readRecords(path, points);
+}
+
+template<typename T>
+bool WriteVec3Binary(const char *path, const Vec3T<T> *points, size_t count) {
+    static_assert(PackedScalar<T>::value, "Vec3T<T> records must be 3 scalars without padding");
+
+    return writeRecords(path, points, count);
+}
+
+template<typename T>
+bool WriteVec3Binary(const char *path, const std::vector<Vec3T<T> > &points) {
+    return WriteVec3Binary(path, points.data(), points.size());
+}
+
+bool LoadPN(const char *path, std::vector<PointNormal> &points) {
+    return readRecords(path, points);
+}
+
+bool SavePN(const char *path, const std::vector<PointNormal> &points) {
+    return writeRecords(path, points.data(), points.size());
+}
+
+void SplitPointNormals(const std::vector<PointNormal> &points, std::vector<Vec3> &positions,
+                       std::vector<Vec3> &normals) {
+    positions.resize(points.size());
+    normals.resize(points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+        positions[i] = points[i].position;
+        normals[i] = points[i].normal;
+    }
+}
+
+#define INSTANTIATE_POINT_IO(T) \
+    template bool ReadVec3Binary<T>(const char *, std::vector<Vec3T<T> > &); \
+    template bool WriteVec3Binary<T>(const char *, const Vec3T<T> *, size_t); \
+    template bool WriteVec3Binary<T>(const char *, const std::vector<Vec3T<T> > &);
+
+INSTANTIATE_POINT_IO(float)
+INSTANTIATE_POINT_IO(double)
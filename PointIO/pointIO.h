@@ -0,0 +1,42 @@
+//
+// Bulk binary I/O of point sets: files hold the raw Vec3 scalars, read and written in one call.
+//
+
+#ifndef MODELISATION_TP1_POINTIO_H
+#define MODELISATION_TP1_POINTIO_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+
+// One record of a .pn file, position then normal, 6 floats with no header (data/igea.pn).
+struct PointNormal {
+    Vec3 position;
+    Vec3 normal;
+};
+
+static_assert(std::is_trivially_copyable<PointNormal>::value && sizeof(PointNormal) == 6 * sizeof(float),
+              "PointNormal is read straight from .pn files");
+
+// Instantiated for float and double only: a long double record would write its padding bytes.
+
+// Reads a whole file of packed Vec3T<T>, replacing the content of points.
+// Fails, leaving points empty, when the file cannot be read or its size is not a whole number of points.
+template<typename T>
+bool ReadVec3Binary(const char *path, std::vector<Vec3T<T> > &points);
+
+template<typename T>
+bool WriteVec3Binary(const char *path, const Vec3T<T> *points, size_t count);
+
+template<typename T>
+bool WriteVec3Binary(const char *path, const std::vector<Vec3T<T> > &points);
+
+bool LoadPN(const char *path, std::vector<PointNormal> &points);
+
+bool SavePN(const char *path, const std::vector<PointNormal> &points);
+
+// Separates positions and normals, e.g. to feed the positions alone to ClosestPointIndex or a GL buffer.
+void SplitPointNormals(const std::vector<PointNormal> &points, std::vector<Vec3> &positions,
+                       std::vector<Vec3> &normals);
+
+#endif //MODELISATION_TP1_POINTIO_H
@@ -0,0 +1,110 @@
+//
+// Rational Bezier curves: control points with weights, able to represent conics exactly.
+//
+
+#include "rationalBezier.h"
+#include "../Casteljau/casteljau.h"
+
+#include <cmath>
+
+// w P and w, reduced together so that every level is one pass over the polygon
+template<typename T>
+struct HomogeneousPoint {
+    Vec3T<T> weighted;
+    T weight;
+
+    static HomogeneousPoint lerp(const HomogeneousPoint &a, const HomogeneousPoint &b, T u) {
+        return {Vec3T<T>::lerp(a.weighted, b.weighted, u), a.weight + (b.weight - a.weight) * u};
+    }
+};
+
+template<typename T>
+static Vec3T<T> rationalPoint(const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &weights, T u,
+                              std::vector<HomogeneousPoint<T> > &heapPoints) {
+    size_t count = controlPoints.size();
+
+    if (count == 0) {
+        return Vec3T<T>(0, 0, 0);
+    }
+
+    assert(weights.size() == count);
+
+    HomogeneousPoint<T> stackPoints[CASTELJAU_STACK_POINTS];
+    HomogeneousPoint<T> *points = stackPoints;
+
+    if (count > CASTELJAU_STACK_POINTS) {
+        heapPoints.resize(count);
+        points = heapPoints.data();
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        points[i] = {weights[i] * controlPoints[i], weights[i]};
+    }
+
+    for (; count > 1; count--) {
+        CasteljauLerpLevel(points, count, u, points);
+    }
+
+    return points[0].weighted / points[0].weight;
+}
+
+template<typename T>
+Vec3T<T> RationalBezierPointByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &weights,
+                                        const typename NonDeduced<T>::type u) {
+    std::vector<HomogeneousPoint<T> > heapPoints;
+
+    return rationalPoint(controlPoints, weights, u, heapPoints);
+}
+
+template<typename T>
+std::vector<Vec3T<T> > RationalBezierCurveByCasteljau(const std::vector<Vec3T<T> > &controlPoints,
+                                                      const std::vector<T> &weights, const long nbU) {
+    std::vector<Vec3T<T> > curvePoints;
+    curvePoints.reserve(nbU);
+
+    std::vector<HomogeneousPoint<T> > heapPoints;
+
+    for (long i = 0; i < nbU; i++) {
+        T u = (T) i / (T) nbU;
+
+        curvePoints.push_back(rationalPoint(controlPoints, weights, u, heapPoints));
+    }
+
+    return curvePoints;
+}
+
+template<typename T>
+void RationalQuadraticArc(const Vec3T<T> &center, const typename NonDeduced<T>::type radius,
+                          const typename NonDeduced<T>::type startAngle, const typename NonDeduced<T>::type endAngle,
+                          std::vector<Vec3T<T> > &controlPoints, std::vector<T> &weights) {
+    T halfSpan = (endAngle - startAngle) / 2;
+    T middleAngle = startAngle + halfSpan;
+    T halfSpanCosine = std::cos(halfSpan);
+
+    // The end tangents meet at radius / cos(halfSpan) on the bisector
+    T middleRadius = radius / halfSpanCosine;
+
+    controlPoints.resize(3);
+    weights.resize(3);
+
+    controlPoints[0] = Vec3T<T>(center[0] + radius * std::cos(startAngle),
+                                center[1] + radius * std::sin(startAngle), center[2]);
+    controlPoints[1] = Vec3T<T>(center[0] + middleRadius * std::cos(middleAngle),
+                                center[1] + middleRadius * std::sin(middleAngle), center[2]);
+    controlPoints[2] = Vec3T<T>(center[0] + radius * std::cos(endAngle),
+                                center[1] + radius * std::sin(endAngle), center[2]);
+
+    weights[0] = 1;
+    weights[1] = halfSpanCosine;
+    weights[2] = 1;
+}
+
+#define INSTANTIATE_RATIONAL_BEZIER(T) \
+    template Vec3T<T> RationalBezierPointByCasteljau<T>(const std::vector<Vec3T<T> > &, const std::vector<T> &, T); \
+    template std::vector<Vec3T<T> > RationalBezierCurveByCasteljau<T>(const std::vector<Vec3T<T> > &, \
+                                                                      const std::vector<T> &, long); \
+    template void RationalQuadraticArc<T>(const Vec3T<T> &, T, T, T, std::vector<Vec3T<T> > &, std::vector<T> &);
+
+INSTANTIATE_RATIONAL_BEZIER(float)
+INSTANTIATE_RATIONAL_BEZIER(double)
+INSTANTIATE_RATIONAL_BEZIER(long double)
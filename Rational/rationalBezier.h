@@ -0,0 +1,34 @@
+//
+// Rational Bezier curves: control points with weights, able to represent conics exactly.
+//
+
+#ifndef MODELISATION_TP1_RATIONALBEZIER_H
+#define MODELISATION_TP1_RATIONALBEZIER_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+
+// Everything here is instantiated for float, double and long double in rationalBezier.cpp.
+
+// Curve at u, computed in homogeneous coordinates: (w_i P_i, w_i) go through the levels of
+// CasteljauLerpLevel in one pass, and one division projects back.
+// Polygons up to CASTELJAU_STACK_POINTS points stay on the stack.
+template<typename T>
+Vec3T<T> RationalBezierPointByCasteljau(const std::vector<Vec3T<T> > &controlPoints, const std::vector<T> &weights,
+                                        typename NonDeduced<T>::type u);
+
+// nbU points at u = i / nbU, like BezierCurveByCasteljau.
+template<typename T>
+std::vector<Vec3T<T> > RationalBezierCurveByCasteljau(const std::vector<Vec3T<T> > &controlPoints,
+                                                      const std::vector<T> &weights, long nbU);
+
+// Exact arc of the circle of the given center and radius in the plane z = center z, from
+// startAngle to endAngle, as a quadratic: the middle point is where the end tangents meet and
+// has weight cos(half the span). The span must stay below pi.
+template<typename T>
+void RationalQuadraticArc(const Vec3T<T> &center, typename NonDeduced<T>::type radius,
+                          typename NonDeduced<T>::type startAngle, typename NonDeduced<T>::type endAngle,
+                          std::vector<Vec3T<T> > &controlPoints, std::vector<T> &weights);
+
+#endif //MODELISATION_TP1_RATIONALBEZIER_H
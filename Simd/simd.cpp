@@ -0,0 +1,186 @@
+//
+// Batch curve evaluation over structure-of-arrays outputs, several parameter values per instruction.
+//
+
+#include "simd.h"
+#include "simdKernels.h"
+
+static bool cpuSupports(SimdIsa isa) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    switch (isa) {
+        case SIMD_SCALAR:
+            return true;
+        case SIMD_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case SIMD_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case SIMD_AVX512:
+            return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == SIMD_SCALAR;
+#endif
+}
+
+static const SimdKernels *kernelsFor(SimdIsa isa) {
+    switch (isa) {
+        case SIMD_SSE2:
+            return SimdKernelsSse2();
+        case SIMD_AVX2:
+            return SimdKernelsAvx2();
+        case SIMD_AVX512:
+            return SimdKernelsAvx512();
+        default:
+            return SimdKernelsScalar();
+    }
+}
+
+static SimdIsa &activeIsa() {
+    static SimdIsa isa = DetectSimdIsa();
+    return isa;
+}
+
+const SimdKernels *ActiveSimdKernels() {
+    return kernelsFor(activeIsa());
+}
+
+bool IsSimdIsaAvailable(SimdIsa isa) {
+    return kernelsFor(isa) != nullptr && cpuSupports(isa);
+}
+
+SimdIsa DetectSimdIsa() {
+    const SimdIsa preferred[] = {SIMD_AVX512, SIMD_AVX2, SIMD_SSE2};
+
+    for (SimdIsa isa : preferred) {
+        if (IsSimdIsaAvailable(isa)) {
+            return isa;
+        }
+    }
+
+    return SIMD_SCALAR;
+}
+
+SimdIsa ActiveSimdIsa() {
+    return activeIsa();
+}
+
+bool SetSimdIsa(SimdIsa isa) {
+    if (!IsSimdIsaAvailable(isa)) {
+        return false;
+    }
+
+    activeIsa() = isa;
+    return true;
+}
+
+const char *SimdIsaName(SimdIsa isa) {
+    switch (isa) {
+        case SIMD_SSE2:
+            return "SSE2";
+        case SIMD_AVX2:
+            return "AVX2";
+        case SIMD_AVX512:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
+
+size_t SimdIsaWidth(SimdIsa isa) {
+    const SimdKernels *kernels = kernelsFor(isa);
+    return kernels ? kernels->width : 0;
+}
+
+void UniformParameters(long nbU, float *us) {
+    for (long i = 0; i < nbU; i++) {
+        us[i] = (float) i / (float) nbU;
+    }
+}
+
+void BezierCurveSoA(const Vec3 *controlPoints, size_t nbPoints, const float *us, size_t count,
+                    float *x, float *y, float *z) {
+    std::vector<float> coordinates(3 * nbPoints);
+    float *cx = coordinates.data();
+    float *cy = cx + nbPoints;
+    float *cz = cy + nbPoints;
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        cx[i] = controlPoints[i][0];
+        cy[i] = controlPoints[i][1];
+        cz[i] = controlPoints[i][2];
+    }
+
+    kernelsFor(activeIsa())->bezier(cx, cy, cz, nbPoints, us, count, x, y, z);
+}
+
+void BezierCurveSoA(const std::vector<Vec3> &controlPoints, const float *us, size_t count,
+                    float *x, float *y, float *z) {
+    BezierCurveSoA(controlPoints.data(), controlPoints.size(), us, count, x, y, z);
+}
+
+void RationalBezierCurveSoA(const Vec3 *controlPoints, const float *weights, size_t nbPoints,
+                            const float *us, size_t count, float *x, float *y, float *z) {
+    std::vector<float> coordinates(4 * nbPoints);
+    float *cx = coordinates.data();
+    float *cy = cx + nbPoints;
+    float *cz = cy + nbPoints;
+    float *cw = cz + nbPoints;
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        // Same products as the scalar path's weights[i] * controlPoints[i]
+        Vec3 weighted = weights[i] * controlPoints[i];
+
+        cx[i] = weighted[0];
+        cy[i] = weighted[1];
+        cz[i] = weighted[2];
+        cw[i] = weights[i];
+    }
+
+    kernelsFor(activeIsa())->rationalBezier(cx, cy, cz, cw, nbPoints, us, count, x, y, z);
+}
+
+void RationalBezierCurveSoA(const std::vector<Vec3> &controlPoints, const std::vector<float> &weights,
+                            const float *us, size_t count, float *x, float *y, float *z) {
+    RationalBezierCurveSoA(controlPoints.data(), weights.data(), controlPoints.size(), us, count, x, y, z);
+}
+
+void HermiteCubicCurveSoA(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1,
+                          const float *us, size_t count, float *x, float *y, float *z) {
+    float coordinates[4][3];
+
+    for (int j = 0; j < 3; j++) {
+        coordinates[0][j] = p0[j];
+        coordinates[1][j] = p1[j];
+        coordinates[2][j] = v0[j];
+        coordinates[3][j] = v1[j];
+    }
+
+    kernelsFor(activeIsa())->hermite(coordinates[0], coordinates[1], coordinates[2], coordinates[3],
+                                     us, count, x, y, z);
+}
+
+void BezierCurveSoA(const std::vector<Vec3> &controlPoints, long nbU, Vec3Array &out) {
+    std::vector<float> us(nbU);
+    UniformParameters(nbU, us.data());
+
+    out.resize(nbU);
+    BezierCurveSoA(controlPoints, us.data(), nbU, out.x(), out.y(), out.z());
+}
+
+void RationalBezierCurveSoA(const std::vector<Vec3> &controlPoints, const std::vector<float> &weights, long nbU,
+                            Vec3Array &out) {
+    std::vector<float> us(nbU);
+    UniformParameters(nbU, us.data());
+
+    out.resize(nbU);
+    RationalBezierCurveSoA(controlPoints, weights, us.data(), nbU, out.x(), out.y(), out.z());
+}
+
+void HermiteCubicCurveSoA(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1, long nbU, Vec3Array &out) {
+    std::vector<float> us(nbU);
+    UniformParameters(nbU, us.data());
+
+    out.resize(nbU);
+    HermiteCubicCurveSoA(p0, p1, v0, v1, us.data(), nbU, out.x(), out.y(), out.z());
+}
@@ -0,0 +1,74 @@
+//
+// Batch curve evaluation over structure-of-arrays outputs, several parameter values per instruction.
+//
+// The kernel set (SSE2, AVX2 or AVX-512, scalar otherwise) is picked once at runtime from the CPU.
+// Every kernel performs the same operations, in the same order, as the scalar evaluators
+// (CasteljauReduce, HermiteCubicCurve and RationalBezierPointByCasteljau) and the SIMD translation units are built with
+// -ffp-contract=off, so results are bitwise identical to the scalar path (0 ULP) as long as
+// the scalar path is itself compiled without FMA contraction. If it is not, each de Casteljau
+// level or Hermite term may differ by the rounding of one fused operation (<= 1 ULP per level).
+// The simd_matches_scalar test checks the 0 ULP bound on every instruction set SetSimdIsa accepts.
+//
+
+#ifndef MODELISATION_TP1_SIMD_H
+#define MODELISATION_TP1_SIMD_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "vec3Array.h"
+
+enum SimdIsa {
+    SIMD_SCALAR = 0,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512
+};
+
+// Best instruction set both compiled in and supported by the running CPU.
+extern SimdIsa DetectSimdIsa();
+
+extern SimdIsa ActiveSimdIsa();
+
+// Forces a given kernel set (benchmarks, comparisons). Returns false, leaving the
+// active set unchanged, when it is not available on this build or CPU.
+extern bool SetSimdIsa(SimdIsa isa);
+
+extern bool IsSimdIsaAvailable(SimdIsa isa);
+
+extern const char *SimdIsaName(SimdIsa isa);
+
+// Number of parameter values a kernel set evaluates per instruction.
+extern size_t SimdIsaWidth(SimdIsa isa);
+
+// us[i] = i / nbU, as used by every tessellator.
+extern void UniformParameters(long nbU, float *us);
+
+// Bezier curve at count parameter values, written to x[i], y[i], z[i].
+extern void BezierCurveSoA(const std::vector<Vec3> &controlPoints, const float *us, size_t count,
+                           float *x, float *y, float *z);
+
+// Rational Bezier curve at count parameter values, homogeneous reduction then one division.
+extern void RationalBezierCurveSoA(const std::vector<Vec3> &controlPoints, const std::vector<float> &weights,
+                                   const float *us, size_t count, float *x, float *y, float *z);
+
+extern void HermiteCubicCurveSoA(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1,
+                                 const float *us, size_t count, float *x, float *y, float *z);
+
+// The same from nbPoints control points and weights read where they lie, e.g. one segment of
+// BezierSegments.
+extern void BezierCurveSoA(const Vec3 *controlPoints, size_t nbPoints, const float *us, size_t count,
+                           float *x, float *y, float *z);
+
+extern void RationalBezierCurveSoA(const Vec3 *controlPoints, const float *weights, size_t nbPoints,
+                                   const float *us, size_t count, float *x, float *y, float *z);
+
+// The same engines at u = i / nbU, written straight into out's lanes, resized to nbU points.
+extern void BezierCurveSoA(const std::vector<Vec3> &controlPoints, long nbU, Vec3Array &out);
+
+extern void RationalBezierCurveSoA(const std::vector<Vec3> &controlPoints, const std::vector<float> &weights, long nbU,
+                                   Vec3Array &out);
+
+extern void HermiteCubicCurveSoA(const Vec3 &p0, const Vec3 &p1, const Vec3 &v0, const Vec3 &v1, long nbU, Vec3Array &out);
+
+#endif //MODELISATION_TP1_SIMD_H
@@ -0,0 +1,53 @@
+//
+// AVX2 kernels of Simd/, 8 parameter values per instruction.
+//
+
+#include "simdKernels.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace {
+
+struct Lane {
+    static const size_t WIDTH = 8;
+    typedef __m256 Vec;
+
+    static Vec load(const float *p) { return _mm256_loadu_ps(p); }
+
+    static void store(float *p, Vec v) { _mm256_storeu_ps(p, v); }
+
+    static Vec set1(float s) { return _mm256_set1_ps(s); }
+
+    static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+
+    static Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+
+    static Vec sqrt(Vec a) { return _mm256_sqrt_ps(a); }
+
+    // a < b ? x : y, lane by lane
+    static Vec selectLess(Vec a, Vec b, Vec x, Vec y) {
+        return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LT_OQ));
+    }
+};
+
+}
+
+#include "simdKernels.inl"
+
+const SimdKernels *SimdKernelsAvx2() {
+    return &laneKernels;
+}
+
+#else
+
+const SimdKernels *SimdKernelsAvx2() {
+    return nullptr;
+}
+
+#endif
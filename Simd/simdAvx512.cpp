@@ -0,0 +1,53 @@
+//
+// AVX-512 kernels of Simd/, 16 parameter values per instruction.
+//
+
+#include "simdKernels.h"
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+namespace {
+
+struct Lane {
+    static const size_t WIDTH = 16;
+    typedef __m512 Vec;
+
+    static Vec load(const float *p) { return _mm512_loadu_ps(p); }
+
+    static void store(float *p, Vec v) { _mm512_storeu_ps(p, v); }
+
+    static Vec set1(float s) { return _mm512_set1_ps(s); }
+
+    static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+
+    static Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+
+    static Vec sqrt(Vec a) { return _mm512_sqrt_ps(a); }
+
+    // a < b ? x : y, lane by lane
+    static Vec selectLess(Vec a, Vec b, Vec x, Vec y) {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), y, x);
+    }
+};
+
+}
+
+#include "simdKernels.inl"
+
+const SimdKernels *SimdKernelsAvx512() {
+    return &laneKernels;
+}
+
+#else
+
+const SimdKernels *SimdKernelsAvx512() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,62 @@
+//
+// Kernel table shared by the per instruction set translation units of Simd/.
+//
+
+#ifndef MODELISATION_TP1_SIMDKERNELS_H
+#define MODELISATION_TP1_SIMDKERNELS_H
+
+#include <cstddef>
+
+struct SimdKernels {
+    size_t width;
+
+    // cx, cy, cz: nbPoints control point coordinates
+    void (*bezier)(const float *cx, const float *cy, const float *cz, size_t nbPoints,
+                   const float *us, size_t count, float *x, float *y, float *z);
+
+    // p0, p1, v0, v1: three coordinates each
+    void (*hermite)(const float *p0, const float *p1, const float *v0, const float *v1,
+                    const float *us, size_t count, float *x, float *y, float *z);
+
+    // cx, cy, cz: weighted control point coordinates w_i P_i, cw: the weights
+    void (*rationalBezier)(const float *cx, const float *cy, const float *cz, const float *cw, size_t nbPoints,
+                           const float *us, size_t count, float *x, float *y, float *z);
+
+    // Element wise over count floats, out may alias the inputs
+    void (*add)(const float *a, const float *b, size_t count, float *out);
+
+    void (*scale)(const float *a, float s, size_t count, float *out);
+
+    void (*lerp)(const float *a, const float *b, float t, size_t count, float *out);
+
+    // Over x, y, z lanes
+    void (*dot)(const float *ax, const float *ay, const float *az, const float *bx, const float *by, const float *bz,
+                size_t count, float *out);
+
+    void (*cross)(const float *ax, const float *ay, const float *az, const float *bx, const float *by, const float *bz,
+                  size_t count, float *x, float *y, float *z);
+
+    void (*normalize)(const float *ax, const float *ay, const float *az, size_t count, float *x, float *y, float *z);
+
+    // m: row major 3x3 matrix, translation: 3 floats or nullptr. Rows summed like Mat3 * Vec3,
+    // then translated. out may alias the inputs.
+    void (*transform)(const float *m, const float *translation, const float *ax, const float *ay, const float *az,
+                      size_t count, float *x, float *y, float *z);
+
+    // a, u, v: 9 lanes each, row major; sigma: 3 lanes. A = U diag(sigma) V^T with sigma decreasing.
+    void (*svd)(const float *const *a, size_t count, float *const *u, float *const *sigma, float *const *v);
+};
+
+// Each returns nullptr when its translation unit was not built for that instruction set.
+extern const SimdKernels *SimdKernelsScalar();
+
+extern const SimdKernels *SimdKernelsSse2();
+
+extern const SimdKernels *SimdKernelsAvx2();
+
+extern const SimdKernels *SimdKernelsAvx512();
+
+// Kernels of ActiveSimdIsa(), never nullptr.
+extern const SimdKernels *ActiveSimdKernels();
+
+#endif //MODELISATION_TP1_SIMDKERNELS_H
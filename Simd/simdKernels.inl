@@ -0,0 +1,485 @@
+//
+// Kernel bodies, included once per instruction set after defining a `Lane` type with:
+//   WIDTH, Vec, load(const float *), store(float *, Vec), set1(float), add, sub, mul, div, sqrt,
+//   selectLess(a, b, x, y) = a < b ? x : y
+// Loads and stores are unaligned, scratch buffers come from std::vector.
+//
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+typedef Lane::Vec LaneVec;
+
+// In place de Casteljau on one coordinate, the lanes holding WIDTH different u.
+LaneVec reduceLanes(float *scratch, const float *c, size_t nbPoints, LaneVec u) {
+    const size_t W = Lane::WIDTH;
+
+    for (size_t j = 0; j < nbPoints; j++) {
+        Lane::store(scratch + j * W, Lane::set1(c[j]));
+    }
+
+    for (size_t count = nbPoints; count > 1; count--) {
+        for (size_t i = 0; i < count - 1; i++) {
+            LaneVec a = Lane::load(scratch + i * W);
+            LaneVec b = Lane::load(scratch + (i + 1) * W);
+
+            Lane::store(scratch + i * W, Lane::add(a, Lane::mul(Lane::sub(b, a), u)));
+        }
+    }
+
+    return Lane::load(scratch);
+}
+
+void bezierKernel(const float *cx, const float *cy, const float *cz, size_t nbPoints,
+                  const float *us, size_t count, float *x, float *y, float *z) {
+    const size_t W = Lane::WIDTH;
+
+    if (nbPoints == 0) {
+        std::fill(x, x + count, 0.0f);
+        std::fill(y, y + count, 0.0f);
+        std::fill(z, z + count, 0.0f);
+        return;
+    }
+
+    std::vector<float> scratch(nbPoints * W);
+    float tail[4][W];
+
+    for (size_t i = 0; i < count; i += W) {
+        size_t n = std::min(W, count - i);
+        const float *u = us + i;
+
+        if (n < W) {
+            std::fill(tail[0], tail[0] + W, 0.0f);
+            std::copy(u, u + n, tail[0]);
+            u = tail[0];
+        }
+
+        LaneVec vu = Lane::load(u);
+        LaneVec px = reduceLanes(scratch.data(), cx, nbPoints, vu);
+        LaneVec py = reduceLanes(scratch.data(), cy, nbPoints, vu);
+        LaneVec pz = reduceLanes(scratch.data(), cz, nbPoints, vu);
+
+        if (n == W) {
+            Lane::store(x + i, px);
+            Lane::store(y + i, py);
+            Lane::store(z + i, pz);
+        } else {
+            Lane::store(tail[1], px);
+            Lane::store(tail[2], py);
+            Lane::store(tail[3], pz);
+            std::copy(tail[1], tail[1] + n, x + i);
+            std::copy(tail[2], tail[2] + n, y + i);
+            std::copy(tail[3], tail[3] + n, z + i);
+        }
+    }
+}
+
+// Same as bezierKernel on the homogeneous coordinates, then one division per coordinate
+void rationalBezierKernel(const float *cx, const float *cy, const float *cz, const float *cw, size_t nbPoints,
+                          const float *us, size_t count, float *x, float *y, float *z) {
+    const size_t W = Lane::WIDTH;
+
+    if (nbPoints == 0) {
+        std::fill(x, x + count, 0.0f);
+        std::fill(y, y + count, 0.0f);
+        std::fill(z, z + count, 0.0f);
+        return;
+    }
+
+    std::vector<float> scratch(nbPoints * W);
+    float tail[4][W];
+
+    for (size_t i = 0; i < count; i += W) {
+        size_t n = std::min(W, count - i);
+        const float *u = us + i;
+
+        if (n < W) {
+            std::fill(tail[0], tail[0] + W, 0.0f);
+            std::copy(u, u + n, tail[0]);
+            u = tail[0];
+        }
+
+        LaneVec vu = Lane::load(u);
+        LaneVec pw = reduceLanes(scratch.data(), cw, nbPoints, vu);
+        LaneVec px = Lane::div(reduceLanes(scratch.data(), cx, nbPoints, vu), pw);
+        LaneVec py = Lane::div(reduceLanes(scratch.data(), cy, nbPoints, vu), pw);
+        LaneVec pz = Lane::div(reduceLanes(scratch.data(), cz, nbPoints, vu), pw);
+
+        if (n == W) {
+            Lane::store(x + i, px);
+            Lane::store(y + i, py);
+            Lane::store(z + i, pz);
+        } else {
+            Lane::store(tail[1], px);
+            Lane::store(tail[2], py);
+            Lane::store(tail[3], pz);
+            std::copy(tail[1], tail[1] + n, x + i);
+            std::copy(tail[2], tail[2] + n, y + i);
+            std::copy(tail[3], tail[3] + n, z + i);
+        }
+    }
+}
+
+void hermiteKernel(const float *p0, const float *p1, const float *v0, const float *v1,
+                   const float *us, size_t count, float *x, float *y, float *z) {
+    const size_t W = Lane::WIDTH;
+
+    LaneVec one = Lane::set1(1.0f);
+    LaneVec two = Lane::set1(2.0f);
+    LaneVec three = Lane::set1(3.0f);
+    LaneVec minusTwo = Lane::set1(-2.0f);
+
+    float *out[3] = {x, y, z};
+    float tail[4][W];
+
+    for (size_t i = 0; i < count; i += W) {
+        size_t n = std::min(W, count - i);
+        const float *us_i = us + i;
+
+        if (n < W) {
+            std::fill(tail[0], tail[0] + W, 0.0f);
+            std::copy(us_i, us_i + n, tail[0]);
+            us_i = tail[0];
+        }
+
+        // Same expressions, same evaluation order as HermiteCubicCurve
+        LaneVec u = Lane::load(us_i);
+        LaneVec uu = Lane::mul(u, u);
+        LaneVec twoU3 = Lane::mul(Lane::mul(Lane::mul(two, u), u), u);
+        LaneVec threeU2 = Lane::mul(Lane::mul(three, u), u);
+        LaneVec u3 = Lane::mul(uu, u);
+
+        LaneVec f1 = Lane::add(Lane::sub(twoU3, threeU2), one);
+        LaneVec f2 = Lane::add(Lane::mul(Lane::mul(Lane::mul(minusTwo, u), u), u), threeU2);
+        LaneVec f3 = Lane::add(Lane::sub(u3, Lane::mul(Lane::mul(two, u), u)), u);
+        LaneVec f4 = Lane::sub(u3, uu);
+
+        for (int j = 0; j < 3; j++) {
+            LaneVec point = Lane::add(
+                    Lane::add(
+                            Lane::add(Lane::mul(f1, Lane::set1(p0[j])), Lane::mul(f2, Lane::set1(p1[j]))),
+                            Lane::mul(f3, Lane::set1(v0[j]))),
+                    Lane::mul(f4, Lane::set1(v1[j])));
+
+            if (n == W) {
+                Lane::store(out[j] + i, point);
+            } else {
+                Lane::store(tail[1 + j], point);
+                std::copy(tail[1 + j], tail[1 + j] + n, out[j] + i);
+            }
+        }
+    }
+}
+
+// Runs op over blocks of WIDTH floats read from NbIn arrays and written to NbOut arrays, the last
+// partial block through zero padded copies. Each block is fully read before it is written,
+// so outputs may alias inputs.
+template<size_t NbIn, size_t NbOut, typename Op>
+void lanesLoop(const float *const (&in)[NbIn], float *const (&out)[NbOut], size_t count, Op op) {
+    const size_t W = Lane::WIDTH;
+    LaneVec a[NbIn];
+    LaneVec r[NbOut];
+    size_t i = 0;
+
+    for (; i + W <= count; i += W) {
+        for (size_t k = 0; k < NbIn; k++) {
+            a[k] = Lane::load(in[k] + i);
+        }
+
+        op(a, r);
+
+        for (size_t k = 0; k < NbOut; k++) {
+            Lane::store(out[k] + i, r[k]);
+        }
+    }
+
+    if (i < count) {
+        float tail[W];
+
+        for (size_t k = 0; k < NbIn; k++) {
+            std::fill(tail, tail + W, 0.0f);
+            std::copy(in[k] + i, in[k] + count, tail);
+            a[k] = Lane::load(tail);
+        }
+
+        op(a, r);
+
+        for (size_t k = 0; k < NbOut; k++) {
+            Lane::store(tail, r[k]);
+            std::copy(tail, tail + (count - i), out[k] + i);
+        }
+    }
+}
+
+void addKernel(const float *a, const float *b, size_t count, float *out) {
+    const float *in[2] = {a, b};
+    float *outs[1] = {out};
+
+    lanesLoop(in, outs, count, [](const LaneVec *v, LaneVec *r) {
+        r[0] = Lane::add(v[0], v[1]);
+    });
+}
+
+void scaleKernel(const float *a, float s, size_t count, float *out) {
+    const float *in[1] = {a};
+    float *outs[1] = {out};
+    LaneVec vs = Lane::set1(s);
+
+    lanesLoop(in, outs, count, [vs](const LaneVec *v, LaneVec *r) {
+        r[0] = Lane::mul(vs, v[0]);
+    });
+}
+
+// Same operations as a de Casteljau level: a + (b - a) t
+void lerpKernel(const float *a, const float *b, float t, size_t count, float *out) {
+    const float *in[2] = {a, b};
+    float *outs[1] = {out};
+    LaneVec vt = Lane::set1(t);
+
+    lanesLoop(in, outs, count, [vt](const LaneVec *v, LaneVec *r) {
+        r[0] = Lane::add(v[0], Lane::mul(Lane::sub(v[1], v[0]), vt));
+    });
+}
+
+// Same order as Vec3::dot, summed from 0
+void dotKernel(const float *ax, const float *ay, const float *az, const float *bx, const float *by, const float *bz,
+               size_t count, float *out) {
+    const float *in[6] = {ax, ay, az, bx, by, bz};
+    float *outs[1] = {out};
+    LaneVec zero = Lane::set1(0.0f);
+
+    lanesLoop(in, outs, count, [zero](const LaneVec *v, LaneVec *r) {
+        LaneVec sum = Lane::add(zero, Lane::mul(v[0], v[3]));
+        sum = Lane::add(sum, Lane::mul(v[1], v[4]));
+        r[0] = Lane::add(sum, Lane::mul(v[2], v[5]));
+    });
+}
+
+void crossKernel(const float *ax, const float *ay, const float *az, const float *bx, const float *by, const float *bz,
+                 size_t count, float *x, float *y, float *z) {
+    const float *in[6] = {ax, ay, az, bx, by, bz};
+    float *outs[3] = {x, y, z};
+
+    lanesLoop(in, outs, count, [](const LaneVec *v, LaneVec *r) {
+        r[0] = Lane::sub(Lane::mul(v[1], v[5]), Lane::mul(v[2], v[4]));
+        r[1] = Lane::sub(Lane::mul(v[2], v[3]), Lane::mul(v[0], v[5]));
+        r[2] = Lane::sub(Lane::mul(v[0], v[4]), Lane::mul(v[1], v[3]));
+    });
+}
+
+// Same operations as Vec3::normalize
+void normalizeKernel(const float *ax, const float *ay, const float *az, size_t count, float *x, float *y, float *z) {
+    const float *in[3] = {ax, ay, az};
+    float *outs[3] = {x, y, z};
+
+    lanesLoop(in, outs, count, [](const LaneVec *v, LaneVec *r) {
+        LaneVec squareLength = Lane::add(Lane::add(Lane::mul(v[0], v[0]), Lane::mul(v[1], v[1])),
+                                         Lane::mul(v[2], v[2]));
+        LaneVec length = Lane::sqrt(squareLength);
+
+        r[0] = Lane::div(v[0], length);
+        r[1] = Lane::div(v[1], length);
+        r[2] = Lane::div(v[2], length);
+    });
+}
+
+// Same operations as Mat3 * Vec3, then + translation
+void transformKernel(const float *m, const float *translation, const float *ax, const float *ay, const float *az,
+                     size_t count, float *x, float *y, float *z) {
+    const float *in[3] = {ax, ay, az};
+    float *outs[3] = {x, y, z};
+    LaneVec vm[9];
+    LaneVec vt[3];
+
+    for (int k = 0; k < 9; k++) {
+        vm[k] = Lane::set1(m[k]);
+    }
+
+    for (int k = 0; k < 3; k++) {
+        vt[k] = Lane::set1(translation != nullptr ? translation[k] : 0.0f);
+    }
+
+    bool translated = translation != nullptr;
+
+    lanesLoop(in, outs, count, [&vm, &vt, translated](const LaneVec *v, LaneVec *r) {
+        for (int row = 0; row < 3; row++) {
+            LaneVec sum = Lane::add(Lane::add(Lane::mul(vm[3 * row], v[0]), Lane::mul(vm[3 * row + 1], v[1])),
+                                    Lane::mul(vm[3 * row + 2], v[2]));
+            r[row] = translated ? Lane::add(sum, vt[row]) : sum;
+        }
+    });
+}
+
+// Sweeps of the batched SVD, enough for float precision without testing convergence lane by lane
+const int SVD_SWEEPS = 6;
+
+LaneVec absLanes(LaneVec a) {
+    LaneVec zero = Lane::set1(0.0f);
+    return Lane::selectLess(a, zero, Lane::sub(zero, a), a);
+}
+
+// Rotates columns p and q of a row major 3x3 matrix held in lanes
+void rotateColumns(LaneVec *m, int p, int q, LaneVec c, LaneVec s) {
+    for (int row = 0; row < 3; row++) {
+        LaneVec mp = m[3 * row + p];
+        LaneVec mq = m[3 * row + q];
+
+        m[3 * row + p] = Lane::sub(Lane::mul(c, mp), Lane::mul(s, mq));
+        m[3 * row + q] = Lane::add(Lane::mul(s, mp), Lane::mul(c, mq));
+    }
+}
+
+// Swaps columns p and q where sigma[p] < sigma[q]
+void sortColumns(LaneVec *b, LaneVec *v, LaneVec *sigma, int p, int q) {
+    LaneVec sp = sigma[p];
+    LaneVec sq = sigma[q];
+
+    sigma[p] = Lane::selectLess(sp, sq, sq, sp);
+    sigma[q] = Lane::selectLess(sp, sq, sp, sq);
+
+    for (int row = 0; row < 3; row++) {
+        for (LaneVec *m : {b, v}) {
+            LaneVec mp = m[3 * row + p];
+            LaneVec mq = m[3 * row + q];
+
+            m[3 * row + p] = Lane::selectLess(sp, sq, mq, mp);
+            m[3 * row + q] = Lane::selectLess(sp, sq, mp, mq);
+        }
+    }
+}
+
+// Same algorithm as Mat3::SVD in float and with a fixed number of sweeps: one sided Jacobi
+// rotations V orthogonalize the columns of B = A V, then B = U Sigma. The matrix is first
+// scaled by its largest coefficient so that the squared column norms stay in range.
+void svdKernel(const float *const *a, size_t count, float *const *u, float *const *sigma, float *const *v) {
+    const float *in[9] = {a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8]};
+    float *outs[21] = {u[0], u[1], u[2], u[3], u[4], u[5], u[6], u[7], u[8], sigma[0], sigma[1], sigma[2],
+                       v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]};
+    LaneVec zero = Lane::set1(0.0f);
+    LaneVec one = Lane::set1(1.0f);
+    LaneVec two = Lane::set1(2.0f);
+    LaneVec rankEpsilon = Lane::set1(8 * std::numeric_limits<float>::epsilon());
+    const int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+
+    lanesLoop(in, outs, count, [&](const LaneVec *m, LaneVec *r) {
+        LaneVec scale = zero;
+
+        for (int k = 0; k < 9; k++) {
+            LaneVec coefficient = absLanes(m[k]);
+            scale = Lane::selectLess(scale, coefficient, coefficient, scale);
+        }
+
+        // A zero matrix keeps a unit scale
+        scale = Lane::selectLess(zero, scale, scale, one);
+        LaneVec invScale = Lane::div(one, scale);
+        LaneVec b[9];
+        LaneVec vm[9];
+
+        for (int k = 0; k < 9; k++) {
+            b[k] = Lane::mul(m[k], invScale);
+            vm[k] = k % 4 == 0 ? one : zero;
+        }
+
+        for (int sweep = 0; sweep < SVD_SWEEPS; sweep++) {
+            for (const int *pair : pairs) {
+                int p = pair[0];
+                int q = pair[1];
+                LaneVec alpha = zero;
+                LaneVec beta = zero;
+                LaneVec gamma = zero;
+
+                for (int row = 0; row < 3; row++) {
+                    alpha = Lane::add(alpha, Lane::mul(b[3 * row + p], b[3 * row + p]));
+                    beta = Lane::add(beta, Lane::mul(b[3 * row + q], b[3 * row + q]));
+                    gamma = Lane::add(gamma, Lane::mul(b[3 * row + p], b[3 * row + q]));
+                }
+
+                // t = tan of the rotation angle, the smaller root, 0 when d and gamma both vanish
+                LaneVec d = Lane::sub(beta, alpha);
+                LaneVec twoGamma = Lane::mul(two, gamma);
+                LaneVec den = Lane::add(absLanes(d), Lane::sqrt(Lane::add(Lane::mul(d, d),
+                                                                          Lane::mul(twoGamma, twoGamma))));
+                LaneVec num = Lane::selectLess(d, zero, Lane::sub(zero, twoGamma), twoGamma);
+                LaneVec t = Lane::selectLess(zero, den, Lane::div(num, den), zero);
+                LaneVec c = Lane::div(one, Lane::sqrt(Lane::add(one, Lane::mul(t, t))));
+                LaneVec s = Lane::mul(c, t);
+
+                rotateColumns(b, p, q, c, s);
+                rotateColumns(vm, p, q, c, s);
+            }
+        }
+
+        LaneVec sv[3];
+
+        for (int col = 0; col < 3; col++) {
+            sv[col] = Lane::sqrt(Lane::add(Lane::add(Lane::mul(b[col], b[col]), Lane::mul(b[3 + col], b[3 + col])),
+                                           Lane::mul(b[6 + col], b[6 + col])));
+        }
+
+        sortColumns(b, vm, sv, 0, 1);
+        sortColumns(b, vm, sv, 1, 2);
+        sortColumns(b, vm, sv, 0, 1);
+
+        // u1 = b1 / s1, (1, 0, 0) for a zero matrix
+        LaneVec inv1 = Lane::selectLess(zero, sv[0], Lane::div(one, sv[0]), zero);
+        LaneVec u1[3] = {Lane::selectLess(zero, sv[0], Lane::mul(b[0], inv1), one),
+                         Lane::mul(b[3], inv1), Lane::mul(b[6], inv1)};
+
+        // u2: b2 made orthogonal to u1, or any unit vector orthogonal to u1 when A has rank 1
+        LaneVec projection = Lane::add(Lane::add(Lane::mul(u1[0], b[1]), Lane::mul(u1[1], b[4])),
+                                       Lane::mul(u1[2], b[7]));
+        LaneVec w[3];
+
+        for (int k = 0; k < 3; k++) {
+            w[k] = Lane::sub(b[3 * k + 1], Lane::mul(projection, u1[k]));
+        }
+
+        LaneVec wLength = Lane::sqrt(Lane::add(Lane::add(Lane::mul(w[0], w[0]), Lane::mul(w[1], w[1])),
+                                               Lane::mul(w[2], w[2])));
+        LaneVec xFirst = Lane::selectLess(Lane::mul(u1[0], u1[0]), Lane::mul(u1[1], u1[1]), one, zero);
+        // u1 x (1, 0, 0) = (0, u1z, -u1y) when u1 leans away from x, u1 x (0, 1, 0) = (-u1z, 0, u1x) otherwise
+        LaneVec perpendicular[3] = {Lane::selectLess(zero, xFirst, zero, Lane::sub(zero, u1[2])),
+                                    Lane::selectLess(zero, xFirst, u1[2], zero),
+                                    Lane::selectLess(zero, xFirst, Lane::sub(zero, u1[1]), u1[0])};
+        LaneVec pLength = Lane::sqrt(Lane::add(Lane::add(Lane::mul(perpendicular[0], perpendicular[0]),
+                                                         Lane::mul(perpendicular[1], perpendicular[1])),
+                                               Lane::mul(perpendicular[2], perpendicular[2])));
+        LaneVec useW = Lane::selectLess(Lane::mul(rankEpsilon, sv[0]), wLength, one, zero);
+        LaneVec u2[3];
+
+        for (int k = 0; k < 3; k++) {
+            u2[k] = Lane::selectLess(zero, useW, Lane::div(w[k], wLength), Lane::div(perpendicular[k], pLength));
+        }
+
+        // u3 = u1 x u2, oriented like b3
+        LaneVec u3[3] = {Lane::sub(Lane::mul(u1[1], u2[2]), Lane::mul(u1[2], u2[1])),
+                         Lane::sub(Lane::mul(u1[2], u2[0]), Lane::mul(u1[0], u2[2])),
+                         Lane::sub(Lane::mul(u1[0], u2[1]), Lane::mul(u1[1], u2[0]))};
+        LaneVec orientation = Lane::add(Lane::add(Lane::mul(u3[0], b[2]), Lane::mul(u3[1], b[5])),
+                                        Lane::mul(u3[2], b[8]));
+
+        for (int k = 0; k < 3; k++) {
+            u3[k] = Lane::selectLess(orientation, zero, Lane::sub(zero, u3[k]), u3[k]);
+            r[3 * k] = u1[k];
+            r[3 * k + 1] = u2[k];
+            r[3 * k + 2] = u3[k];
+        }
+
+        for (int k = 0; k < 3; k++) {
+            r[9 + k] = Lane::mul(sv[k], scale);
+        }
+
+        for (int k = 0; k < 9; k++) {
+            r[12 + k] = vm[k];
+        }
+    });
+}
+
+const SimdKernels laneKernels = {Lane::WIDTH, bezierKernel, hermiteKernel, rationalBezierKernel,
+                                 addKernel, scaleKernel, lerpKernel, dotKernel, crossKernel, normalizeKernel,
+                                 transformKernel, svdKernel};
+
+}
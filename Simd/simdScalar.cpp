@@ -0,0 +1,41 @@
+//
+// Scalar fallback of the Simd/ kernels, one parameter value at a time.
+//
+
+#include "simdKernels.h"
+
+#include <cmath>
+
+namespace {
+
+struct Lane {
+    static const size_t WIDTH = 1;
+    typedef float Vec;
+
+    static Vec load(const float *p) { return *p; }
+
+    static void store(float *p, Vec v) { *p = v; }
+
+    static Vec set1(float s) { return s; }
+
+    static Vec add(Vec a, Vec b) { return a + b; }
+
+    static Vec sub(Vec a, Vec b) { return a - b; }
+
+    static Vec mul(Vec a, Vec b) { return a * b; }
+
+    static Vec div(Vec a, Vec b) { return a / b; }
+
+    static Vec sqrt(Vec a) { return std::sqrt(a); }
+
+    // a < b ? x : y
+    static Vec selectLess(Vec a, Vec b, Vec x, Vec y) { return a < b ? x : y; }
+};
+
+}
+
+#include "simdKernels.inl"
+
+const SimdKernels *SimdKernelsScalar() {
+    return &laneKernels;
+}
@@ -0,0 +1,54 @@
+//
+// SSE2 kernels of Simd/, 4 parameter values per instruction.
+//
+
+#include "simdKernels.h"
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+namespace {
+
+struct Lane {
+    static const size_t WIDTH = 4;
+    typedef __m128 Vec;
+
+    static Vec load(const float *p) { return _mm_loadu_ps(p); }
+
+    static void store(float *p, Vec v) { _mm_storeu_ps(p, v); }
+
+    static Vec set1(float s) { return _mm_set1_ps(s); }
+
+    static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+
+    static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+
+    static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+
+    static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+
+    static Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+
+    // a < b ? x : y, lane by lane
+    static Vec selectLess(Vec a, Vec b, Vec x, Vec y) {
+        Vec mask = _mm_cmplt_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+    }
+};
+
+}
+
+#include "simdKernels.inl"
+
+const SimdKernels *SimdKernelsSse2() {
+    return &laneKernels;
+}
+
+#else
+
+const SimdKernels *SimdKernelsSse2() {
+    return nullptr;
+}
+
+#endif
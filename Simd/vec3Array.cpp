@@ -0,0 +1,183 @@
+//
+// Points stored as structure of arrays: separate aligned x, y and z lanes, with whole array kernels.
+//
+
+#include "vec3Array.h"
+#include "simdKernels.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+static const size_t FLOATS_PER_ALIGNMENT = VEC3ARRAY_ALIGNMENT / sizeof(float);
+
+static size_t strideFor(size_t size) {
+    return (size + FLOATS_PER_ALIGNMENT - 1) / FLOATS_PER_ALIGNMENT * FLOATS_PER_ALIGNMENT;
+}
+
+// Zeroed block of 3 stride floats
+static float *allocateLanes(size_t stride) {
+    if (stride == 0) {
+        return nullptr;
+    }
+
+    void *block = nullptr;
+
+    if (posix_memalign(&block, VEC3ARRAY_ALIGNMENT, 3 * stride * sizeof(float)) != 0) {
+        throw std::bad_alloc();
+    }
+
+    float *data = static_cast<float *>(block);
+    std::fill(data, data + 3 * stride, 0.0f);
+
+    return data;
+}
+
+Vec3Array::Vec3Array(size_t size) : mData(allocateLanes(strideFor(size))), mSize(size), mStride(strideFor(size)) {}
+
+Vec3Array::Vec3Array(const std::vector<Vec3> &points) : Vec3Array(points.size()) {
+    for (size_t i = 0; i < points.size(); i++) {
+        set(i, points[i]);
+    }
+}
+
+Vec3Array::Vec3Array(const Vec3Array &other)
+        : mData(allocateLanes(other.mStride)), mSize(other.mSize), mStride(other.mStride) {
+    std::copy(other.mData, other.mData + 3 * mStride, mData);
+}
+
+Vec3Array &Vec3Array::operator=(const Vec3Array &other) {
+    if (this != &other) {
+        Vec3Array copy(other);
+
+        std::swap(mData, copy.mData);
+        std::swap(mSize, copy.mSize);
+        std::swap(mStride, copy.mStride);
+    }
+
+    return *this;
+}
+
+Vec3Array::Vec3Array(Vec3Array &&other) noexcept : mData(other.mData), mSize(other.mSize), mStride(other.mStride) {
+    other.mData = nullptr;
+    other.mSize = 0;
+    other.mStride = 0;
+}
+
+Vec3Array &Vec3Array::operator=(Vec3Array &&other) noexcept {
+    if (this != &other) {
+        free(mData);
+
+        mData = other.mData;
+        mSize = other.mSize;
+        mStride = other.mStride;
+
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mStride = 0;
+    }
+
+    return *this;
+}
+
+Vec3Array::~Vec3Array() {
+    free(mData);
+}
+
+void Vec3Array::resize(size_t size) {
+    size_t stride = strideFor(size);
+
+    if (stride == mStride) {
+        // Points past the new size are zeroed, so that a later growth exposes zeros
+        for (size_t i = size; i < mSize; i++) {
+            set(i, Vec3(0, 0, 0));
+        }
+
+        mSize = size;
+        return;
+    }
+
+    float *data = allocateLanes(stride);
+    size_t kept = std::min(size, mSize);
+
+    for (int lane = 0; lane < 3; lane++) {
+        std::copy(mData + lane * mStride, mData + lane * mStride + kept, data + lane * stride);
+    }
+
+    free(mData);
+
+    mData = data;
+    mSize = size;
+    mStride = stride;
+}
+
+std::vector<Vec3> Vec3Array::toVector() const {
+    std::vector<Vec3> points(mSize);
+
+    for (size_t i = 0; i < mSize; i++) {
+        points[i] = get(i);
+    }
+
+    return points;
+}
+
+void Vec3ArrayAdd(ConstVec3ArrayView a, ConstVec3ArrayView b, Vec3ArrayView out) {
+    assert(a.size == b.size && a.size == out.size);
+
+    const SimdKernels *kernels = ActiveSimdKernels();
+    kernels->add(a.x, b.x, a.size, out.x);
+    kernels->add(a.y, b.y, a.size, out.y);
+    kernels->add(a.z, b.z, a.size, out.z);
+}
+
+void Vec3ArrayScale(ConstVec3ArrayView a, float s, Vec3ArrayView out) {
+    assert(a.size == out.size);
+
+    const SimdKernels *kernels = ActiveSimdKernels();
+    kernels->scale(a.x, s, a.size, out.x);
+    kernels->scale(a.y, s, a.size, out.y);
+    kernels->scale(a.z, s, a.size, out.z);
+}
+
+void Vec3ArrayLerp(ConstVec3ArrayView a, ConstVec3ArrayView b, float t, Vec3ArrayView out) {
+    assert(a.size == b.size && a.size == out.size);
+
+    const SimdKernels *kernels = ActiveSimdKernels();
+    kernels->lerp(a.x, b.x, t, a.size, out.x);
+    kernels->lerp(a.y, b.y, t, a.size, out.y);
+    kernels->lerp(a.z, b.z, t, a.size, out.z);
+}
+
+void Vec3ArrayDot(ConstVec3ArrayView a, ConstVec3ArrayView b, float *out) {
+    assert(a.size == b.size);
+
+    ActiveSimdKernels()->dot(a.x, a.y, a.z, b.x, b.y, b.z, a.size, out);
+}
+
+void Vec3ArrayCross(ConstVec3ArrayView a, ConstVec3ArrayView b, Vec3ArrayView out) {
+    assert(a.size == b.size && a.size == out.size);
+
+    ActiveSimdKernels()->cross(a.x, a.y, a.z, b.x, b.y, b.z, a.size, out.x, out.y, out.z);
+}
+
+void Vec3ArrayNormalize(ConstVec3ArrayView a, Vec3ArrayView out) {
+    assert(a.size == out.size);
+
+    ActiveSimdKernels()->normalize(a.x, a.y, a.z, a.size, out.x, out.y, out.z);
+}
+
+void Vec3ArrayToInterleaved(ConstVec3ArrayView a, float *xyz) {
+    for (size_t i = 0; i < a.size; i++) {
+        xyz[3 * i] = a.x[i];
+        xyz[3 * i + 1] = a.y[i];
+        xyz[3 * i + 2] = a.z[i];
+    }
+}
+
+void Vec3ArrayFromInterleaved(const float *xyz, Vec3ArrayView out) {
+    for (size_t i = 0; i < out.size; i++) {
+        out.x[i] = xyz[3 * i];
+        out.y[i] = xyz[3 * i + 1];
+        out.z[i] = xyz[3 * i + 2];
+    }
+}
@@ -0,0 +1,124 @@
+//
+// Points stored as structure of arrays: separate aligned x, y and z lanes, with whole array kernels.
+//
+
+#ifndef MODELISATION_TP1_VEC3ARRAY_H
+#define MODELISATION_TP1_VEC3ARRAY_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+
+// Lanes start on this many bytes, and hold a multiple of VEC3ARRAY_ALIGNMENT / sizeof(float) floats.
+static const size_t VEC3ARRAY_ALIGNMENT = 64;
+
+// Non owning lanes of size points: a whole Vec3Array, a range of one, or SoA buffers of another owner
+// (BezierCurveSoA outputs, mapped buffers). Kernels run on views, nothing is copied.
+struct Vec3ArrayView {
+    float *x;
+    float *y;
+    float *z;
+    size_t size;
+};
+
+struct ConstVec3ArrayView {
+    const float *x;
+    const float *y;
+    const float *z;
+    size_t size;
+
+    ConstVec3ArrayView(const float *x, const float *y, const float *z, size_t size) : x(x), y(y), z(z), size(size) {}
+
+    ConstVec3ArrayView(const Vec3ArrayView &view) : x(view.x), y(view.y), z(view.z), size(view.size) {}
+};
+
+class Vec3Array {
+public:
+    explicit Vec3Array(size_t size = 0);
+
+    explicit Vec3Array(const std::vector<Vec3> &points);
+
+    Vec3Array(const Vec3Array &other);
+
+    Vec3Array &operator=(const Vec3Array &other);
+
+    // Takes other's lanes, other is left empty.
+    Vec3Array(Vec3Array &&other) noexcept;
+
+    Vec3Array &operator=(Vec3Array &&other) noexcept;
+
+    ~Vec3Array();
+
+    size_t size() const { return mSize; }
+
+    // Keeps the first min(size, newSize) points, new points are zero.
+    void resize(size_t size);
+
+    float *x() { return mData; }
+
+    float *y() { return mData + mStride; }
+
+    float *z() { return mData + 2 * mStride; }
+
+    const float *x() const { return mData; }
+
+    const float *y() const { return mData + mStride; }
+
+    const float *z() const { return mData + 2 * mStride; }
+
+    Vec3 get(size_t i) const { return Vec3(x()[i], y()[i], z()[i]); }
+
+    void set(size_t i, const Vec3 &p) {
+        x()[i] = p[0];
+        y()[i] = p[1];
+        z()[i] = p[2];
+    }
+
+    Vec3ArrayView view() { return view(0, mSize); }
+
+    ConstVec3ArrayView view() const { return view(0, mSize); }
+
+    Vec3ArrayView view(size_t begin, size_t end) {
+        Vec3ArrayView lanes = {x() + begin, y() + begin, z() + begin, end - begin};
+        return lanes;
+    }
+
+    ConstVec3ArrayView view(size_t begin, size_t end) const {
+        return ConstVec3ArrayView(x() + begin, y() + begin, z() + begin, end - begin);
+    }
+
+    std::vector<Vec3> toVector() const;
+
+private:
+    // x, y and z lanes of mStride floats each, back to back in one aligned block
+    float *mData;
+    size_t mSize;
+    size_t mStride;
+};
+
+// Element wise kernels, through the active Simd/ kernel set. Sizes must match, out may be an input.
+// Results are bitwise those of the Vec3 operators on each point.
+
+// out = a + b
+extern void Vec3ArrayAdd(ConstVec3ArrayView a, ConstVec3ArrayView b, Vec3ArrayView out);
+
+// out = s a
+extern void Vec3ArrayScale(ConstVec3ArrayView a, float s, Vec3ArrayView out);
+
+// out = a + (b - a) t
+extern void Vec3ArrayLerp(ConstVec3ArrayView a, ConstVec3ArrayView b, float t, Vec3ArrayView out);
+
+// out[i] = Vec3::dot(a[i], b[i])
+extern void Vec3ArrayDot(ConstVec3ArrayView a, ConstVec3ArrayView b, float *out);
+
+extern void Vec3ArrayCross(ConstVec3ArrayView a, ConstVec3ArrayView b, Vec3ArrayView out);
+
+extern void Vec3ArrayNormalize(ConstVec3ArrayView a, Vec3ArrayView out);
+
+// Interleaved x y z x y z ..., as glVertexPointer or a mapped GL buffer expects, 3 size floats.
+// Written and read in place, no intermediate copy.
+extern void Vec3ArrayToInterleaved(ConstVec3ArrayView a, float *xyz);
+
+extern void Vec3ArrayFromInterleaved(const float *xyz, Vec3ArrayView out);
+
+#endif //MODELISATION_TP1_VEC3ARRAY_H
@@ -0,0 +1,69 @@
+//
+// Singular value decompositions of many 3x3 matrices at once, through the Simd/ kernels.
+//
+
+#include <algorithm>
+#include "svd.h"
+#include "../Simd/simdKernels.h"
+
+// Matrices gathered per kernel call, 30 stack lanes of 256 bytes
+static const size_t SVD_BLOCK = 64;
+
+void Mat3SVDBatch(const Mat3 *matrices, size_t count, Mat3 *U, Vec3 *sigma, Mat3 *Vt, ThreadPool &pool) {
+    const SimdKernels *kernels = ActiveSimdKernels();
+
+    RangeTask task = [&](size_t begin, size_t end) {
+        float lanes[30][SVD_BLOCK];
+        const float *a[9];
+        float *u[9];
+        float *s[3];
+        float *v[9];
+
+        for (int k = 0; k < 9; k++) {
+            a[k] = lanes[k];
+            u[k] = lanes[9 + k];
+            v[k] = lanes[21 + k];
+        }
+
+        for (int k = 0; k < 3; k++) {
+            s[k] = lanes[18 + k];
+        }
+
+        for (size_t i = begin; i < end; i += SVD_BLOCK) {
+            size_t n = std::min(SVD_BLOCK, end - i);
+
+            for (size_t m = 0; m < n; m++) {
+                for (unsigned int k = 0; k < 9; k++) {
+                    lanes[k][m] = matrices[i + m](k / 3, k % 3);
+                }
+            }
+
+            kernels->svd(a, n, u, s, v);
+
+            for (size_t m = 0; m < n; m++) {
+                sigma[i + m] = Vec3(s[0][m], s[1][m], s[2][m]);
+
+                for (unsigned int k = 0; k < 9; k++) {
+                    if (U != nullptr) {
+                        U[i + m](k / 3, k % 3) = u[k][m];
+                    }
+
+                    if (Vt != nullptr) {
+                        Vt[i + m](k % 3, k / 3) = v[k][m];
+                    }
+                }
+            }
+        }
+    };
+
+    if (count < SVD_PARALLEL_THRESHOLD) {
+        task(0, count);
+        return;
+    }
+
+    pool.parallelFor(count, SVD_GRAIN, task);
+}
+
+void Mat3SVDBatch(const Mat3 *matrices, size_t count, Mat3 *U, Vec3 *sigma, Mat3 *Vt) {
+    Mat3SVDBatch(matrices, count, U, sigma, Vt, DefaultThreadPool());
+}
@@ -0,0 +1,25 @@
+//
+// Singular value decompositions of many 3x3 matrices at once, through the Simd/ kernels.
+//
+
+#ifndef MODELISATION_TP1_SVD_H
+#define MODELISATION_TP1_SVD_H
+
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "../Batch/threadPool.h"
+
+// Below this many matrices the decompositions run on the calling thread.
+static const size_t SVD_PARALLEL_THRESHOLD = 1 << 12;
+
+// Matrices per task handed to the pool.
+static const size_t SVD_GRAIN = 1 << 10;
+
+// matrices[i] = U[i] diag(sigma[i]) Vt[i], with Mat3::SVD's conventions but in float and with a fixed
+// number of Jacobi sweeps, so one SIMD lane per matrix. U or Vt may be nullptr when not needed, e.g.
+// for the eigenvalues alone of covariance matrices, whose eigenvectors are the columns of U.
+extern void Mat3SVDBatch(const Mat3 *matrices, size_t count, Mat3 *U, Vec3 *sigma, Mat3 *Vt, ThreadPool &pool);
+
+extern void Mat3SVDBatch(const Mat3 *matrices, size_t count, Mat3 *U, Vec3 *sigma, Mat3 *Vt);
+
+#endif //MODELISATION_TP1_SVD_H
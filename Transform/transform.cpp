@@ -0,0 +1,101 @@
+//
+// Linear and affine transforms of whole point sets, through the Simd/ kernels and a ThreadPool.
+//
+
+#include "transform.h"
+#include "../Simd/simdKernels.h"
+
+namespace {
+
+// Row major matrix as the kernel reads it
+void matrixRows(const Mat3 &m, float *rows) {
+    for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            rows[3 * i + j] = m(i, j);
+        }
+    }
+}
+
+// Runs task on [0, count), over the pool once count reaches TRANSFORM_PARALLEL_THRESHOLD
+void forRange(size_t count, ThreadPool &pool, const RangeTask &task) {
+    if (count < TRANSFORM_PARALLEL_THRESHOLD) {
+        task(0, count);
+        return;
+    }
+
+    pool.parallelFor(count, TRANSFORM_GRAIN, task);
+}
+
+template<typename Op>
+void transformInterleaved(const Vec3 *in, size_t count, Vec3 *out, ThreadPool &pool, Op op) {
+    forRange(count, pool, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            out[i] = op(in[i]);
+        }
+    });
+}
+
+}
+
+AffineTransform Compose(const AffineTransform &a, const AffineTransform &b) {
+    return AffineTransform(a.linear * b.linear, a.linear * b.translation + a.translation);
+}
+
+Mat3 ComposeChain(const std::vector<Mat3> &transforms) {
+    Mat3 product = Mat3::Identity();
+
+    for (const Mat3 &m : transforms) {
+        product = product * m;
+    }
+
+    return product;
+}
+
+AffineTransform ComposeChain(const std::vector<AffineTransform> &transforms) {
+    AffineTransform product;
+
+    for (const AffineTransform &transform : transforms) {
+        product = Compose(product, transform);
+    }
+
+    return product;
+}
+
+void TransformPoints(const Mat3 &m, const Vec3 *in, size_t count, Vec3 *out, ThreadPool &pool) {
+    transformInterleaved(in, count, out, pool, [&m](const Vec3 &p) { return m * p; });
+}
+
+void TransformPoints(const Mat3 &m, const Vec3 *in, size_t count, Vec3 *out) {
+    TransformPoints(m, in, count, out, DefaultThreadPool());
+}
+
+void TransformPoints(const AffineTransform &transform, const Vec3 *in, size_t count, Vec3 *out,
+                     ThreadPool &pool) {
+    transformInterleaved(in, count, out, pool, [&transform](const Vec3 &p) { return transform(p); });
+}
+
+void TransformPoints(const AffineTransform &transform, const Vec3 *in, size_t count, Vec3 *out) {
+    TransformPoints(transform, in, count, out, DefaultThreadPool());
+}
+
+void TransformPoints(const AffineTransform &transform, std::vector<Vec3> &points) {
+    TransformPoints(transform, points.data(), points.size(), points.data());
+}
+
+void TransformPoints(const AffineTransform &transform, ConstVec3ArrayView in, Vec3ArrayView out,
+                     ThreadPool &pool) {
+    assert(in.size == out.size);
+    const SimdKernels *kernels = ActiveSimdKernels();
+    float rows[9];
+    float translation[3] = {transform.translation[0], transform.translation[1], transform.translation[2]};
+    matrixRows(transform.linear, rows);
+
+    forRange(in.size, pool, [&](size_t begin, size_t end) {
+        kernels->transform(rows, translation, in.x + begin, in.y + begin, in.z + begin, end - begin,
+                           out.x + begin, out.y + begin, out.z + begin);
+    });
+}
+
+void TransformPoints(const AffineTransform &transform, ConstVec3ArrayView in, Vec3ArrayView out) {
+    TransformPoints(transform, in, out, DefaultThreadPool());
+}
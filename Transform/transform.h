@@ -0,0 +1,61 @@
+//
+// Linear and affine transforms of whole point sets, through the Simd/ kernels and a ThreadPool.
+//
+
+#ifndef MODELISATION_TP1_TRANSFORM_H
+#define MODELISATION_TP1_TRANSFORM_H
+
+#include <vector>
+#include <cstddef>
+#include "../src/Vec3.h"
+#include "../Batch/threadPool.h"
+#include "../Simd/vec3Array.h"
+
+// p -> linear p + translation
+struct AffineTransform {
+    Mat3 linear;
+    Vec3 translation;
+
+    constexpr AffineTransform() : linear(Mat3::Identity()), translation(0, 0, 0) {}
+
+    constexpr AffineTransform(const Mat3 &linear, const Vec3 &translation) : linear(linear), translation(translation) {}
+
+    constexpr Vec3 operator()(const Vec3 &p) const { return linear * p + translation; }
+};
+
+// Below this many points the transform runs on the calling thread.
+static const size_t TRANSFORM_PARALLEL_THRESHOLD = 1 << 16;
+
+// Points per task handed to the pool.
+static const size_t TRANSFORM_GRAIN = 1 << 14;
+
+// a after b: Compose(a, b)(p) == a(b(p)).
+extern AffineTransform Compose(const AffineTransform &a, const AffineTransform &b);
+
+// Product of the chain, transforms[0] applied last. Composing once and transforming the points once
+// costs one pass over the points instead of one per transform.
+extern Mat3 ComposeChain(const std::vector<Mat3> &transforms);
+
+extern AffineTransform ComposeChain(const std::vector<AffineTransform> &transforms);
+
+// out[i] = m * in[i], out may be in. Interleaved points go through Mat3 * Vec3 point by point:
+// gathering them to SoA blocks for the SIMD kernel measured slower than the scalar loop.
+extern void TransformPoints(const Mat3 &m, const Vec3 *in, size_t count, Vec3 *out, ThreadPool &pool);
+
+extern void TransformPoints(const Mat3 &m, const Vec3 *in, size_t count, Vec3 *out);
+
+extern void TransformPoints(const AffineTransform &transform, const Vec3 *in, size_t count, Vec3 *out,
+                            ThreadPool &pool);
+
+extern void TransformPoints(const AffineTransform &transform, const Vec3 *in, size_t count, Vec3 *out);
+
+// In place over a vector
+extern void TransformPoints(const AffineTransform &transform, std::vector<Vec3> &points);
+
+// SoA lanes, straight through the SIMD kernel, bitwise the same results. Sizes must match, out may be in.
+extern void TransformPoints(const AffineTransform &transform, ConstVec3ArrayView in, Vec3ArrayView out,
+                            ThreadPool &pool);
+
+extern void TransformPoints(const AffineTransform &transform, ConstVec3ArrayView in, Vec3ArrayView out);
+
+#endif //MODELISATION_TP1_TRANSFORM_H
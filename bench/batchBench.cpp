@@ -0,0 +1,64 @@
+//
+// Batch tessellation: scaling of each engine from 1 thread to the number of cores (at least 4).
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include "bench.h"
+#include "../Batch/batch.h"
+
+void BenchBatch() {
+    const size_t nbCurves = 20000;
+    const long nbU = 100;
+    char variant[64];
+    unsigned int nbCores = std::max(4u, std::thread::hardware_concurrency());
+
+    CurveBatch bezierCurves;
+    CurveBatch hermiteCurves;
+    std::vector<Vec3> controlPoints = BenchPolygon(6);
+
+    for (size_t c = 0; c < nbCurves; c++) {
+        controlPoints[c % controlPoints.size()] += Vec3(0.001f, 0, 0);
+        bezierCurves.addCurve(controlPoints);
+        hermiteCurves.addCurve(std::vector<Vec3>(controlPoints.begin(), controlPoints.begin() + 4));
+    }
+
+    std::vector<unsigned int> threadCounts;
+
+    for (unsigned int n = 1; n < nbCores; n *= 2) {
+        threadCounts.push_back(n);
+    }
+
+    threadCounts.push_back(nbCores);
+
+    const struct {
+        CurveEngine engine;
+        const char *name;
+        const CurveBatch *curves;
+    } engines[] = {{ENGINE_CASTELJAU, "casteljau", &bezierCurves},
+                   {ENGINE_BERNSTEIN, "bernstein", &bezierCurves},
+                   {ENGINE_HERMITE,   "hermite",   &hermiteCurves}};
+
+    for (const auto &engine : engines) {
+        double singleThread = 0;
+
+        for (unsigned int nbThreads : threadCounts) {
+            ThreadPool pool(nbThreads);
+            TessellatedBatch batch;
+
+            double seconds = BenchSeconds([&]() {
+                batch = TessellateBatch(*engine.curves, engine.engine, nbU, pool);
+            });
+            BenchKeep(batch.points);
+
+            if (nbThreads == 1) {
+                singleThread = seconds;
+            }
+
+            std::snprintf(variant, sizeof(variant), "%s, %u threads, speedup %.2f", engine.name, nbThreads,
+                          singleThread / seconds);
+            BenchReport("batch", variant, nbCurves * nbU, seconds);
+        }
+    }
+}
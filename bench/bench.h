@@ -0,0 +1,58 @@
+//
+// Timing helpers for the curveBench executable. Numbers are only meaningful in an optimized
+// build: cmake -DCMAKE_BUILD_TYPE=Release.
+//
+
+#ifndef MODELISATION_TP1_BENCH_H
+#define MODELISATION_TP1_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "../src/Vec3.h"
+
+// Repetitions of each measurement, the fastest one is reported.
+static const int BENCH_REPEATS = 5;
+
+// Best wall time of BENCH_REPEATS calls of run, in seconds.
+template<typename Run>
+double BenchSeconds(Run run) {
+    double best = 0;
+
+    for (int i = 0; i < BENCH_REPEATS; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (i == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+
+    return best;
+}
+
+// One line per measurement: case, variant, time and throughput over items.
+extern void BenchReport(const char *benchCase, const char *variant, size_t items, double seconds);
+
+// Folds results into a global, so that the measured work cannot be optimized away.
+extern void BenchKeep(const std::vector<Vec3> &points);
+
+extern void BenchKeep(const Vec3 &point);
+
+// Control polygon of nbPoints points on a smooth, non planar path, the same for every run.
+extern std::vector<Vec3> BenchPolygon(size_t nbPoints);
+
+// Benchmark cases, defined next to the module they measure and listed in main.cpp.
+void BenchBernstein();
+void BenchSimd();
+void BenchForwardDifferencing();
+void BenchBatch();
+void BenchMonomial();
+void BenchHermiteTrack();
+void BenchIntersection();
+void BenchBSpline();
+void BenchPointIO();
+void BenchVectorMath();
+
+#endif //MODELISATION_TP1_BENCH_H
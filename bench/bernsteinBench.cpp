@@ -0,0 +1,80 @@
+//
+// Bernstein engine: the O(n) basis recurrence against the previous per term evaluation.
+//
+
+#include <cmath>
+#include <cstdio>
+#include "bench.h"
+#include "../Berstein/berstein.h"
+#include "../Casteljau/casteljau.h"
+
+// The evaluation BernsteinBasis replaced: factorial binomials and two pow per term.
+// Exact only up to degree 20, where factorial overflows.
+static unsigned long factorialBinomial(unsigned long n, unsigned long k) {
+    return factorial(n) / (factorial(k) * factorial(n - k));
+}
+
+static std::vector<Vec3> perTermCurve(const std::vector<Vec3> &controlPoints, long nbU) {
+    std::vector<Vec3> curvePoints;
+    curvePoints.reserve(nbU);
+    unsigned long n = controlPoints.size() - 1;
+
+    for (long i = 0; i < nbU; i++) {
+        float u = (float) i / (float) nbU;
+        Vec3 point(0, 0, 0);
+
+        for (unsigned long k = 0; k <= n; k++) {
+            float b = factorialBinomial(n, k) * std::pow(u, k) * std::pow(1 - u, n - k);
+            point += b * controlPoints[k];
+        }
+
+        curvePoints.push_back(point);
+    }
+
+    return curvePoints;
+}
+
+static float maxDistance(const std::vector<Vec3> &a, const std::vector<Vec3> &b) {
+    float distance = 0;
+
+    for (size_t i = 0; i < a.size(); i++) {
+        distance = std::max(distance, (a[i] - b[i]).length());
+    }
+
+    return distance;
+}
+
+void BenchBernstein() {
+    const long nbU = 10000;
+    char variant[64];
+
+    for (size_t degree : {3, 10, 20, 100, 500}) {
+        std::vector<Vec3> controlPoints = BenchPolygon(degree + 1);
+        std::vector<Vec3> curve;
+
+        std::snprintf(variant, sizeof(variant), "degree %zu, BernsteinBasis", degree);
+        BenchReport("bernstein", variant, nbU, BenchSeconds([&]() {
+            curve = BezierCurveByBernstein(controlPoints, nbU);
+        }));
+        BenchKeep(curve);
+
+        std::vector<Vec3> reference = BezierCurveByCasteljau(controlPoints, nbU);
+        std::printf("%-14s %-44s max distance to de Casteljau %g\n", "bernstein", variant,
+                    maxDistance(curve, reference));
+
+        if (degree > 20) {
+            continue;
+        }
+
+        std::vector<Vec3> previous;
+
+        std::snprintf(variant, sizeof(variant), "degree %zu, factorial and pow", degree);
+        BenchReport("bernstein", variant, nbU, BenchSeconds([&]() {
+            previous = perTermCurve(controlPoints, nbU);
+        }));
+        BenchKeep(previous);
+
+        std::printf("%-14s %-44s max distance to de Casteljau %g\n", "bernstein", variant,
+                    maxDistance(previous, reference));
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Cubic B-splines from 1k to 1M control points: span by span tessellation through the Bezier
+// kernels, de Boor per sample, and gsl_bspline, which evaluates the basis only.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <gsl/gsl_bspline.h>
+#include <gsl/gsl_vector.h>
+#include "bench.h"
+#include "../BSpline/bspline.h"
+
+// Samples per span.
+static const long BSPLINE_BENCH_NBU = 8;
+
+// The same curve through gsl_bspline: the order + 1 non zero basis functions at t, combined with
+// the control points they act on. gsl_bspline_eval would fill all nbPoints functions per sample.
+static std::vector<Vec3> gslCurve(const std::vector<Vec3> &controlPoints, size_t degree,
+                                  const std::vector<double> &ts) {
+    size_t nbPoints = controlPoints.size();
+    gsl_bspline_workspace *workspace = gsl_bspline_alloc(degree + 1, nbPoints - degree + 1);
+    gsl_vector *basis = gsl_vector_alloc(degree + 1);
+    std::vector<Vec3> curvePoints(ts.size());
+
+    // Clamped with uniform breakpoints, the knots of ClampedUniformKnots
+    gsl_bspline_knots_uniform(0.0, 1.0, workspace);
+
+    for (size_t i = 0; i < ts.size(); i++) {
+        size_t first;
+        size_t last;
+        double point[3] = {0, 0, 0};
+
+        gsl_bspline_eval_nonzero(ts[i], basis, &first, &last, workspace);
+
+        for (size_t k = first; k <= last; k++) {
+            double b = gsl_vector_get(basis, k - first);
+
+            for (int j = 0; j < 3; j++) {
+                point[j] += b * controlPoints[k][j];
+            }
+        }
+
+        curvePoints[i] = Vec3(point[0], point[1], point[2]);
+    }
+
+    gsl_vector_free(basis);
+    gsl_bspline_free(workspace);
+
+    return curvePoints;
+}
+
+void BenchBSpline() {
+    const size_t degree = 3;
+    char variant[64];
+
+    for (size_t nbPoints : {1000, 10000, 100000, 1000000}) {
+        BSpline spline(degree, BenchPolygon(nbPoints), ClampedUniformKnots<float>(nbPoints, degree));
+        size_t nbSpans = nbPoints - degree;
+        size_t nbSamples = nbSpans * BSPLINE_BENCH_NBU;
+        std::vector<Vec3> curve;
+
+        std::snprintf(variant, sizeof(variant), "%zu points, curve (Bezier spans)", nbPoints);
+        BenchReport("bspline", variant, nbSamples, BenchSeconds([&]() {
+            curve = spline.curve(BSPLINE_BENCH_NBU);
+        }));
+        BenchKeep(curve);
+
+        std::vector<double> ts(nbSamples);
+
+        for (size_t i = 0; i < nbSamples; i++) {
+            ts[i] = (double) i / (double) nbSamples;
+        }
+
+        std::vector<Vec3> deBoor(nbSamples);
+
+        std::snprintf(variant, sizeof(variant), "%zu points, de Boor per sample", nbPoints);
+        BenchReport("bspline", variant, nbSamples, BenchSeconds([&]() {
+            for (size_t i = 0; i < nbSamples; i++) {
+                deBoor[i] = spline.point((float) ts[i]);
+            }
+        }));
+        BenchKeep(deBoor);
+
+        std::vector<Vec3> gsl;
+
+        std::snprintf(variant, sizeof(variant), "%zu points, gsl_bspline_eval_nonzero", nbPoints);
+        BenchReport("bspline", variant, nbSamples, BenchSeconds([&]() {
+            gsl = gslCurve(spline.controlPoints(), degree, ts);
+        }));
+        BenchKeep(gsl);
+
+        float distance = 0;
+
+        for (size_t i = 0; i < nbSamples; i++) {
+            distance = std::max(distance, (deBoor[i] - gsl[i]).length());
+        }
+
+        std::printf("%-14s %-44s max distance to de Boor %g\n", "bspline", variant, distance);
+    }
+}
@@ -0,0 +1,48 @@
+//
+// Forward differencing against per sample evaluation of cubic segments, at nbU = 100, 10k and 1M.
+//
+
+#include <cstdio>
+#include "bench.h"
+#include "../ForwardDifferencing/forwardDifferencing.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+
+void BenchForwardDifferencing() {
+    char variant[64];
+    Vec3 p0(0, 0, 0);
+    Vec3 p1(1, 0.5f, 0);
+    Vec3 v0(1, 2, 0);
+    Vec3 v1(1, -2, 0.5f);
+    std::vector<Vec3> controlPoints = BenchPolygon(4);
+    std::vector<Vec3> curve;
+
+    for (long nbU : {100L, 10000L, 1000000L}) {
+        std::snprintf(variant, sizeof(variant), "hermite nbU %ld, HermiteCubicCurve", nbU);
+        BenchReport("forwardDiff", variant, nbU, BenchSeconds([&]() {
+            curve = HermiteCubicCurve(p0, p1, v0, v1, nbU);
+        }));
+        BenchKeep(curve);
+
+        std::snprintf(variant, sizeof(variant), "hermite nbU %ld, forward differencing", nbU);
+        BenchReport("forwardDiff", variant, nbU, BenchSeconds([&]() {
+            curve = HermiteCubicCurveByForwardDifferencing(p0, p1, v0, v1, nbU);
+        }));
+        BenchKeep(curve);
+
+        std::snprintf(variant, sizeof(variant), "bezier nbU %ld, BezierCurveByCasteljau", nbU);
+        BenchReport("forwardDiff", variant, nbU, BenchSeconds([&]() {
+            curve = BezierCurveByCasteljau(controlPoints, nbU);
+        }));
+        BenchKeep(curve);
+
+        std::snprintf(variant, sizeof(variant), "bezier nbU %ld, forward differencing", nbU);
+        BenchReport("forwardDiff", variant, nbU, BenchSeconds([&]() {
+            curve = BezierCubicCurveByForwardDifferencing(controlPoints, nbU);
+        }));
+        BenchKeep(curve);
+
+        std::printf("%-14s %-44s error bound %g\n", "forwardDiff", variant,
+                    ForwardDifferencingErrorBound(BezierCubicPolynomial(controlPoints), nbU));
+    }
+}
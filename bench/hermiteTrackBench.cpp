@@ -0,0 +1,104 @@
+//
+// Hermite track lookup: cursor and binary search against a linear scan, from 10 to 1M keys,
+// over sequential (playback) and random queries.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include "bench.h"
+#include "../Hermite/hermite.h"
+#include "../Hermite/hermiteTrack.h"
+
+// Past this many keys the linear scan is not measured, a million scans of a million keys would
+// dominate the whole run.
+static const size_t TRACK_BENCH_SCAN_KEYS = 10000;
+
+// The lookup the track replaced: first segment whose end key comes after time.
+static Vec3 linearScanSample(const std::vector<float> &times, const std::vector<Vec3> &values,
+                             const std::vector<Vec3> &tangents, float time) {
+    if (time <= times.front()) {
+        return values.front();
+    }
+
+    if (time >= times.back()) {
+        return values.back();
+    }
+
+    size_t segment = 0;
+
+    while (times[segment + 1] <= time) {
+        segment++;
+    }
+
+    float duration = times[segment + 1] - times[segment];
+
+    return HermiteCubicPoint(values[segment], values[segment + 1], duration * tangents[segment],
+                             duration * tangents[segment + 1], (time - times[segment]) / duration);
+}
+
+void BenchHermiteTrack() {
+    const size_t nbQueries = 1000000;
+    char variant[64];
+    std::mt19937 generator(1);
+
+    for (size_t nbKeys : {10, 1000, 100000, 1000000}) {
+        std::vector<float> times(nbKeys);
+        std::vector<Vec3> values = BenchPolygon(nbKeys);
+        std::vector<Vec3> tangents(nbKeys);
+
+        for (size_t i = 0; i < nbKeys; i++) {
+            times[i] = (float) i;
+            tangents[i] = values[std::min(i + 1, nbKeys - 1)] - values[i > 0 ? i - 1 : 0];
+        }
+
+        HermiteTrack track(times, values, tangents);
+
+        std::vector<float> sequential(nbQueries);
+
+        for (size_t i = 0; i < nbQueries; i++) {
+            sequential[i] = times.back() * (float) i / (float) nbQueries;
+        }
+
+        std::vector<float> random = sequential;
+        std::shuffle(random.begin(), random.end(), generator);
+
+        std::vector<Vec3> samples(nbQueries);
+
+        const struct {
+            const char *name;
+            const std::vector<float> *queries;
+        } orders[] = {{"sequential", &sequential}, {"random", &random}};
+
+        for (const auto &order : orders) {
+            const std::vector<float> &queries = *order.queries;
+
+            std::snprintf(variant, sizeof(variant), "%zu keys, %s, cursor", nbKeys, order.name);
+            BenchReport("hermiteTrack", variant, nbQueries, BenchSeconds([&]() {
+                track.resetCursor();
+                track.sample(queries.data(), nbQueries, samples.data());
+            }));
+            BenchKeep(samples);
+
+            std::snprintf(variant, sizeof(variant), "%zu keys, %s, binary search", nbKeys, order.name);
+            BenchReport("hermiteTrack", variant, nbQueries, BenchSeconds([&]() {
+                for (size_t i = 0; i < nbQueries; i++) {
+                    samples[i] = track.sampleAt(queries[i]);
+                }
+            }));
+            BenchKeep(samples);
+
+            if (nbKeys > TRACK_BENCH_SCAN_KEYS) {
+                continue;
+            }
+
+            std::snprintf(variant, sizeof(variant), "%zu keys, %s, linear scan", nbKeys, order.name);
+            BenchReport("hermiteTrack", variant, nbQueries, BenchSeconds([&]() {
+                for (size_t i = 0; i < nbQueries; i++) {
+                    samples[i] = linearScanSample(times, values, tangents, queries[i]);
+                }
+            }));
+            BenchKeep(samples);
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//
+// Intersections in random soups of cubic curves: the sort and sweep broad phase against testing
+// every pair, from 100 to 10k curves.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "bench.h"
+#include "../Bounds/bounds.h"
+#include "../Intersection/intersection.h"
+
+// Past this many curves the all pairs variants are not measured.
+static const size_t INTERSECTION_BENCH_BRUTE_CURVES = 2000;
+
+static const float INTERSECTION_BENCH_TOLERANCE = 1e-4f;
+
+// nbCurves planar cubics of about curveSize, scattered over the unit square.
+static std::vector<std::vector<Vec3> > curveSoup(size_t nbCurves, float curveSize) {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> position(0, 1);
+    std::uniform_real_distribution<float> offset(-curveSize, curveSize);
+    std::vector<std::vector<Vec3> > curves(nbCurves);
+
+    for (size_t i = 0; i < nbCurves; i++) {
+        Vec3 start(position(generator), position(generator), 0);
+
+        for (int k = 0; k < 4; k++) {
+            curves[i].push_back(start + Vec3(offset(generator), offset(generator), 0));
+        }
+    }
+
+    return curves;
+}
+
+// Every pair through the narrow phase, as BezierIntersections does without its broad phase.
+static std::vector<CurveIntersection> allPairsIntersections(const std::vector<std::vector<Vec3> > &curves) {
+    std::vector<CurveIntersection> intersections;
+
+    for (size_t i = 0; i < curves.size(); i++) {
+        std::vector<CurveIntersection> hits = BezierSelfIntersections(curves[i], INTERSECTION_BENCH_TOLERANCE);
+        intersections.insert(intersections.end(), hits.begin(), hits.end());
+
+        for (size_t j = i + 1; j < curves.size(); j++) {
+            hits = BezierIntersections(curves[i], curves[j], INTERSECTION_BENCH_TOLERANCE);
+            intersections.insert(intersections.end(), hits.begin(), hits.end());
+        }
+    }
+
+    return intersections;
+}
+
+void BenchIntersection() {
+    char variant[64];
+
+    for (size_t nbCurves : {100, 1000, 10000}) {
+        // Curves shrink as the soup grows, so that each one meets a few others
+        std::vector<std::vector<Vec3> > curves = curveSoup(nbCurves, 2.0f / std::sqrt((float) nbCurves));
+        std::vector<AABB> boxes(nbCurves);
+
+        for (size_t i = 0; i < nbCurves; i++) {
+            boxes[i] = BezierBounds(curves[i]);
+        }
+
+        std::vector<std::pair<size_t, size_t> > pairs;
+        std::vector<CurveIntersection> intersections;
+
+        std::snprintf(variant, sizeof(variant), "%zu curves, broad phase, sweep", nbCurves);
+        BenchReport("intersection", variant, nbCurves, BenchSeconds([&]() {
+            pairs = OverlappingBoxPairs(boxes);
+        }));
+
+        std::printf("%-14s %-44s %zu candidate pairs of %zu\n", "intersection", variant, pairs.size(),
+                    nbCurves * (nbCurves - 1) / 2);
+
+        std::snprintf(variant, sizeof(variant), "%zu curves, broad phase, all pairs", nbCurves);
+        BenchReport("intersection", variant, nbCurves, BenchSeconds([&]() {
+            pairs.clear();
+
+            for (size_t i = 0; i < nbCurves; i++) {
+                for (size_t j = i + 1; j < nbCurves; j++) {
+                    if (boxes[i].overlaps(boxes[j])) {
+                        pairs.emplace_back(i, j);
+                    }
+                }
+            }
+        }));
+
+        std::snprintf(variant, sizeof(variant), "%zu curves, BezierIntersections", nbCurves);
+        BenchReport("intersection", variant, nbCurves, BenchSeconds([&]() {
+            intersections = BezierIntersections(curves, INTERSECTION_BENCH_TOLERANCE);
+        }));
+
+        std::printf("%-14s %-44s %zu intersections\n", "intersection", variant, intersections.size());
+
+        if (nbCurves > INTERSECTION_BENCH_BRUTE_CURVES) {
+            continue;
+        }
+
+        std::snprintf(variant, sizeof(variant), "%zu curves, narrow phase on all pairs", nbCurves);
+        BenchReport("intersection", variant, nbCurves, BenchSeconds([&]() {
+            intersections = allPairsIntersections(curves);
+        }));
+
+        std::printf("%-14s %-44s %zu intersections\n", "intersection", variant, intersections.size());
+    }
+}
@@ -0,0 +1,82 @@
+//
+// Runs the benchmark cases named on the command line, or all of them.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "bench.h"
+
+struct BenchCase {
+    const char *name;
+    void (*run)();
+};
+
+static const BenchCase BENCH_CASES[] = {
+        {"bernstein", BenchBernstein},
+        {"simd", BenchSimd},
+        {"forwardDiff", BenchForwardDifferencing},
+        {"batch", BenchBatch},
+        {"monomial", BenchMonomial},
+        {"hermiteTrack", BenchHermiteTrack},
+        {"intersection", BenchIntersection},
+        {"bspline", BenchBSpline},
+        {"pointIO", BenchPointIO},
+        {"vectorMath", BenchVectorMath},
+};
+
+static volatile float gKept = 0;
+
+void BenchReport(const char *benchCase, const char *variant, size_t items, double seconds) {
+    std::printf("%-14s %-44s %10.3f ms %10.2f M/s\n", benchCase, variant, 1e3 * seconds,
+                seconds > 0 ? 1e-6 * (double) items / seconds : 0.0);
+}
+
+void BenchKeep(const std::vector<Vec3> &points) {
+    if (!points.empty()) {
+        BenchKeep(points[points.size() / 2]);
+    }
+}
+
+void BenchKeep(const Vec3 &point) {
+    gKept = gKept + point[0] + point[1] + point[2];
+}
+
+std::vector<Vec3> BenchPolygon(size_t nbPoints) {
+    std::vector<Vec3> points(nbPoints);
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        float t = nbPoints > 1 ? (float) i / (float) (nbPoints - 1) : 0.0f;
+        points[i] = Vec3(t, std::sin(7 * t), std::cos(3 * t) * t);
+    }
+
+    return points;
+}
+
+int main(int argc, char **argv) {
+#ifndef NDEBUG
+    std::printf("warning: assertions are on, configure with -DCMAKE_BUILD_TYPE=Release for meaningful numbers\n");
+#endif
+
+    int ran = 0;
+
+    for (const BenchCase &benchCase : BENCH_CASES) {
+        bool selected = argc < 2;
+
+        for (int i = 1; i < argc; i++) {
+            selected = selected || std::strcmp(argv[i], benchCase.name) == 0;
+        }
+
+        if (selected) {
+            benchCase.run();
+            ran++;
+        }
+    }
+
+    if (ran == 0) {
+        std::fprintf(stderr, "no benchmark case matches\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+//
+// Monomial basis: Horner and Estrin against the de Casteljau and Bernstein engines, in
+// throughput and in distance to a long double de Casteljau reference.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include "bench.h"
+#include "../Berstein/berstein.h"
+#include "../Berstein/monomial.h"
+#include "../Casteljau/casteljau.h"
+
+void BenchMonomial() {
+    const long nbU = 100000;
+    char variant[64];
+
+    // 41 points is past MONOMIAL_MAX_POINTS, both schemes then fall back to de Casteljau
+    for (size_t degree : {3, 5, 10, 20, 31, 40}) {
+        std::vector<Vec3> controlPoints = BenchPolygon(degree + 1);
+        std::vector<Vec3ld> referencePoints(controlPoints.begin(), controlPoints.end());
+        MonomialCurve monomial(controlPoints);
+
+        std::printf("%-14s degree %zu, condition number %g, %s\n", "monomial", degree, monomial.conditionNumber(),
+                    monomial.usesMonomialBasis() ? "monomial basis used" : "point() keeps de Casteljau");
+
+        const struct {
+            const char *name;
+            Vec3 (*point)(const MonomialCurve &, const std::vector<Vec3> &, float);
+        } engines[] = {
+                {"Horner",      [](const MonomialCurve &curve, const std::vector<Vec3> &, float u) {
+                    return curve.pointByHorner(u);
+                }},
+                {"Estrin",      [](const MonomialCurve &curve, const std::vector<Vec3> &, float u) {
+                    return curve.pointByEstrin(u);
+                }},
+                {"de Casteljau", [](const MonomialCurve &, const std::vector<Vec3> &points, float u) {
+                    return BezierPointByCasteljau(points, u);
+                }},
+                {"Bernstein",   [](const MonomialCurve &, const std::vector<Vec3> &points, float u) {
+                    return BezierPointByBernstein(points, u);
+                }}};
+
+        for (const auto &engine : engines) {
+            std::snprintf(variant, sizeof(variant), "degree %zu, %s", degree, engine.name);
+            BenchReport("monomial", variant, nbU, BenchSeconds([&]() {
+                for (long i = 0; i < nbU; i++) {
+                    BenchKeep(engine.point(monomial, controlPoints, (float) i / (float) nbU));
+                }
+            }));
+
+            long double distance = 0;
+
+            for (long i = 0; i < nbU; i += 97) {
+                float u = (float) i / (float) nbU;
+                Vec3ld reference = BezierPointByCasteljau(referencePoints, (long double) u);
+
+                distance = std::max(distance, (Vec3ld(engine.point(monomial, controlPoints, u)) - reference).length());
+            }
+
+            std::printf("%-14s %-44s max distance to long double %Lg\n", "monomial", variant, distance);
+        }
+    }
+}
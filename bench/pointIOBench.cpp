@@ -0,0 +1,135 @@
+//
+// Trivially copyable Vec3: vector growth and copies against a copy of the previous Vec3, and
+// LoadPN's single fread against one fread per record.
+//
+
+#include <cstdio>
+#include "bench.h"
+#include "../PointIO/pointIO.h"
+
+// The Vec3 before it became trivially copyable: a user provided default constructor and
+// assignment, so std::vector moves it element by element instead of in one memmove.
+class LegacyVec3 {
+public:
+    LegacyVec3() {}
+
+    LegacyVec3(float x, float y, float z) {
+        mVals[0] = x;
+        mVals[1] = y;
+        mVals[2] = z;
+    }
+
+    float operator[](unsigned int c) const { return mVals[c]; }
+
+    void operator=(const LegacyVec3 &other) {
+        mVals[0] = other[0];
+        mVals[1] = other[1];
+        mVals[2] = other[2];
+    }
+
+private:
+    float mVals[3];
+};
+
+static const char *POINT_IO_BENCH_FILE = "curveBench.pn";
+
+template<typename Point>
+static std::vector<Point> grownVector(size_t count) {
+    std::vector<Point> points;
+
+    for (size_t i = 0; i < count; i++) {
+        points.push_back(Point((float) i, 1, 2));
+    }
+
+    return points;
+}
+
+// The per record loop LoadPN replaces.
+static bool loadPNPerRecord(const char *path, std::vector<PointNormal> &points) {
+    FILE *file = std::fopen(path, "rb");
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    points.clear();
+    float record[6];
+
+    while (std::fread(record, sizeof(float), 6, file) == 6) {
+        PointNormal point;
+        point.position = Vec3(record[0], record[1], record[2]);
+        point.normal = Vec3(record[3], record[4], record[5]);
+        points.push_back(point);
+    }
+
+    std::fclose(file);
+
+    return true;
+}
+
+void BenchPointIO() {
+    char variant[64];
+
+    for (size_t count : {100000, 10000000}) {
+        std::vector<Vec3> points;
+        std::vector<LegacyVec3> legacyPoints;
+
+        std::snprintf(variant, sizeof(variant), "%zu push_back, Vec3", count);
+        BenchReport("pointIO", variant, count, BenchSeconds([&]() {
+            points = grownVector<Vec3>(count);
+        }));
+        BenchKeep(points);
+
+        std::snprintf(variant, sizeof(variant), "%zu push_back, previous Vec3", count);
+        BenchReport("pointIO", variant, count, BenchSeconds([&]() {
+            legacyPoints = grownVector<LegacyVec3>(count);
+        }));
+
+        std::vector<Vec3> copy;
+
+        std::snprintf(variant, sizeof(variant), "%zu vector copy, Vec3", count);
+        BenchReport("pointIO", variant, count, BenchSeconds([&]() {
+            copy = std::vector<Vec3>(points);
+        }));
+        BenchKeep(copy);
+
+        std::vector<LegacyVec3> legacyCopy;
+
+        std::snprintf(variant, sizeof(variant), "%zu vector copy, previous Vec3", count);
+        BenchReport("pointIO", variant, count, BenchSeconds([&]() {
+            legacyCopy = std::vector<LegacyVec3>(legacyPoints);
+        }));
+        BenchKeep(Vec3(legacyCopy.back()[0], legacyCopy.front()[1], legacyCopy[count / 2][2]));
+    }
+
+    // The size of data/igea.pn, and ten times more
+    for (size_t count : {134345, 1343450}) {
+        std::vector<PointNormal> records(count);
+
+        for (size_t i = 0; i < count; i++) {
+            records[i].position = Vec3((float) i, 0, 1);
+            records[i].normal = Vec3(0, 0, 1);
+        }
+
+        if (!SavePN(POINT_IO_BENCH_FILE, records)) {
+            std::printf("%-14s cannot write %s\n", "pointIO", POINT_IO_BENCH_FILE);
+            return;
+        }
+
+        std::vector<PointNormal> loaded;
+
+        std::snprintf(variant, sizeof(variant), "%zu records, LoadPN", count);
+        BenchReport("pointIO", variant, count, BenchSeconds([&]() {
+            LoadPN(POINT_IO_BENCH_FILE, loaded);
+        }));
+        BenchKeep(loaded.back().position);
+
+        std::snprintf(variant, sizeof(variant), "%zu records, fread per record", count);
+        BenchReport("pointIO", variant, count, BenchSeconds([&]() {
+            loadPNPerRecord(POINT_IO_BENCH_FILE, loaded);
+        }));
+        BenchKeep(loaded.back().position);
+
+        std::remove(POINT_IO_BENCH_FILE);
+    }
+}
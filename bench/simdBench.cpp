@@ -0,0 +1,66 @@
+//
+// SIMD kernels: points per second of each instruction set, next to the scalar engines.
+//
+
+#include <cstdio>
+#include "bench.h"
+#include "../Simd/simd.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+
+void BenchSimd() {
+    const long nbU = 1000000;
+    char variant[64];
+    std::vector<float> us(nbU);
+    std::vector<float> x(nbU);
+    std::vector<float> y(nbU);
+    std::vector<float> z(nbU);
+    UniformParameters(nbU, us.data());
+
+    Vec3 p0(0, 0, 0);
+    Vec3 p1(1, 0.5f, 0);
+    Vec3 v0(1, 2, 0);
+    Vec3 v1(1, -2, 0.5f);
+    std::vector<Vec3> curve;
+
+    for (size_t nbPoints : {4, 11}) {
+        std::vector<Vec3> controlPoints = BenchPolygon(nbPoints);
+
+        std::snprintf(variant, sizeof(variant), "bezier degree %zu, scalar Casteljau", nbPoints - 1);
+        BenchReport("simd", variant, nbU, BenchSeconds([&]() {
+            curve = BezierCurveByCasteljau(controlPoints, nbU);
+        }));
+        BenchKeep(curve);
+    }
+
+    BenchReport("simd", "hermite, scalar HermiteCubicCurve", nbU, BenchSeconds([&]() {
+        curve = HermiteCubicCurve(p0, p1, v0, v1, nbU);
+    }));
+    BenchKeep(curve);
+
+    SimdIsa active = ActiveSimdIsa();
+
+    for (SimdIsa isa : {SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512}) {
+        if (!SetSimdIsa(isa)) {
+            std::printf("%-14s %-44s not available\n", "simd", SimdIsaName(isa));
+            continue;
+        }
+
+        for (size_t nbPoints : {4, 11}) {
+            std::vector<Vec3> controlPoints = BenchPolygon(nbPoints);
+
+            std::snprintf(variant, sizeof(variant), "bezier degree %zu, %s", nbPoints - 1, SimdIsaName(isa));
+            BenchReport("simd", variant, nbU, BenchSeconds([&]() {
+                BezierCurveSoA(controlPoints, us.data(), nbU, x.data(), y.data(), z.data());
+            }));
+        }
+
+        std::snprintf(variant, sizeof(variant), "hermite, %s", SimdIsaName(isa));
+        BenchReport("simd", variant, nbU, BenchSeconds([&]() {
+            HermiteCubicCurveSoA(p0, p1, v0, v1, us.data(), nbU, x.data(), y.data(), z.data());
+        }));
+        BenchKeep(Vec3(x[nbU / 2], y[nbU / 2], z[nbU / 2]));
+    }
+
+    SetSimdIsa(active);
+}
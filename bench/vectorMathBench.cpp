@@ -0,0 +1,91 @@
+//
+// Temporaries in the inner loops: lerp in the de Casteljau levels and per coordinate accumulators
+// in the Bernstein sum, against the same loops written with named Vec3 temporaries.
+//
+
+#include <cstdio>
+#include "bench.h"
+#include "../Berstein/berstein.h"
+#include "../Casteljau/casteljau.h"
+
+// CasteljauReduce as it was: v = b - a, v *= u, a + v, each a Vec3 of its own.
+static Vec3 temporariesReduce(Vec3 *points, size_t count, float u) {
+    for (; count > 1; count--) {
+        for (size_t i = 0; i < count - 1; i++) {
+            Vec3 v = points[i + 1] - points[i];
+            v *= u;
+
+            points[i] = points[i] + v;
+        }
+    }
+
+    return points[0];
+}
+
+// The Bernstein sum as addedPoint *= B; point += addedPoint, in BezierPointFromBasis's wide scalar.
+static Vec3 temporariesSum(const Vec3 *controlPoints, size_t nbPoints, const double *basis) {
+    Vec3d point(0, 0, 0);
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        Vec3d addedPoint(controlPoints[i]);
+        addedPoint *= basis[i];
+        point += addedPoint;
+    }
+
+    return Vec3(point);
+}
+
+void BenchVectorMath() {
+    const long nbU = 100000;
+    char variant[64];
+
+#ifndef NDEBUG
+    std::printf("%-14s unoptimized build, where the temporaries are not removed by the compiler\n", "vectorMath");
+#endif
+
+    for (size_t degree : {3, 11, 31}) {
+        std::vector<Vec3> controlPoints = BenchPolygon(degree + 1);
+        std::vector<Vec3> points(controlPoints.size());
+
+        std::snprintf(variant, sizeof(variant), "degree %zu, de Casteljau, lerp", degree);
+        BenchReport("vectorMath", variant, nbU, BenchSeconds([&]() {
+            for (long i = 0; i < nbU; i++) {
+                std::copy(controlPoints.begin(), controlPoints.end(), points.begin());
+                BenchKeep(CasteljauReduce(points.data(), points.size(), (float) i / (float) nbU));
+            }
+        }));
+
+        std::snprintf(variant, sizeof(variant), "degree %zu, de Casteljau, temporaries", degree);
+        BenchReport("vectorMath", variant, nbU, BenchSeconds([&]() {
+            for (long i = 0; i < nbU; i++) {
+                std::copy(controlPoints.begin(), controlPoints.end(), points.begin());
+                BenchKeep(temporariesReduce(points.data(), points.size(), (float) i / (float) nbU));
+            }
+        }));
+
+        // Bases are computed beforehand so that only the sum is measured, several of them so that
+        // the inlined temporaries loop cannot be hoisted out as loop invariant
+        const size_t nbBases = 64;
+        std::vector<double> bases(nbBases * controlPoints.size());
+
+        for (size_t k = 0; k < nbBases; k++) {
+            BernsteinBasis<double>(degree, (double) k / (double) nbBases, &bases[k * controlPoints.size()]);
+        }
+
+        std::snprintf(variant, sizeof(variant), "degree %zu, Bernstein sum, accumulators", degree);
+        BenchReport("vectorMath", variant, nbU, BenchSeconds([&]() {
+            for (long i = 0; i < nbU; i++) {
+                BenchKeep(BezierPointFromBasis(controlPoints.data(), controlPoints.size(),
+                                               &bases[(i % nbBases) * controlPoints.size()]));
+            }
+        }));
+
+        std::snprintf(variant, sizeof(variant), "degree %zu, Bernstein sum, temporaries", degree);
+        BenchReport("vectorMath", variant, nbU, BenchSeconds([&]() {
+            for (long i = 0; i < nbU; i++) {
+                BenchKeep(temporariesSum(controlPoints.data(), controlPoints.size(),
+                                         &bases[(i % nbBases) * controlPoints.size()]));
+            }
+        }));
+    }
+}
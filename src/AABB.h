@@ -0,0 +1,86 @@
+#ifndef AABB_H
+#define AABB_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include "Vec3.h"
+
+// Axis aligned bounding box. A default constructed box is empty: min above max on every axis,
+// so that the first extend() sets it.
+template<typename T>
+struct AABBT {
+    Vec3T<T> min;
+    Vec3T<T> max;
+
+    AABBT() : min(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()),
+              max(-std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(), -std::numeric_limits<T>::max()) {}
+
+    AABBT(const Vec3T<T> &min, const Vec3T<T> &max) : min(min), max(max) {}
+
+    // Box of count points, e.g. a control polygon, which bounds its curve by the convex hull property.
+    static AABBT ofPoints(const Vec3T<T> *points, size_t count) {
+        AABBT box;
+
+        for (size_t i = 0; i < count; i++) {
+            box.extend(points[i]);
+        }
+
+        return box;
+    }
+
+    bool empty() const { return min[0] > max[0] || min[1] > max[1] || min[2] > max[2]; }
+
+    void extend(const Vec3T<T> &p) {
+        for (unsigned int c = 0; c < 3; c++) {
+            min[c] = std::min(min[c], p[c]);
+            max[c] = std::max(max[c], p[c]);
+        }
+    }
+
+    void extend(const AABBT &other) {
+        extend(other.min);
+        extend(other.max);
+    }
+
+    // Grows the box by margin on every side.
+    void inflate(T margin) {
+        for (unsigned int c = 0; c < 3; c++) {
+            min[c] -= margin;
+            max[c] += margin;
+        }
+    }
+
+    // True when the boxes are closer than margin on every axis.
+    bool overlaps(const AABBT &other, T margin = 0) const {
+        for (unsigned int c = 0; c < 3; c++) {
+            if (min[c] > other.max[c] + margin || other.min[c] > max[c] + margin) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Vec3T<T> center() const { return (T) 0.5 * (min + max); }
+
+    Vec3T<T> extent() const { return max - min; }
+
+    T diagonal() const { return empty() ? 0 : extent().length(); }
+
+    // Squared distance from p to the box, 0 inside.
+    T squareDistance(const Vec3T<T> &p) const {
+        T result = 0;
+
+        for (unsigned int c = 0; c < 3; c++) {
+            T d = std::max(std::max(min[c] - p[c], p[c] - max[c]), (T) 0);
+            result += d * d;
+        }
+
+        return result;
+    }
+};
+
+typedef AABBT<float> AABB;
+
+#endif //AABB_H
@@ -0,0 +1,40 @@
+#ifndef CURVEDIFFERENTIALS_H
+#define CURVEDIFFERENTIALS_H
+
+#include <vector>
+#include "Vec3.h"
+
+// Position, first and second derivatives and curvature of a curve at each sample,
+// one array per quantity.
+template<typename T>
+struct CurveDifferentialsT {
+    std::vector<Vec3T<T> > positions;
+    std::vector<Vec3T<T> > firstDerivatives;
+    std::vector<Vec3T<T> > secondDerivatives;
+    std::vector<T> curvatures;
+
+    void resize(size_t size) {
+        positions.resize(size);
+        firstDerivatives.resize(size);
+        secondDerivatives.resize(size);
+        curvatures.resize(size);
+    }
+
+    size_t size() const { return positions.size(); }
+};
+
+typedef CurveDifferentialsT<float> CurveDifferentials;
+
+// |c' x c''| / |c'|^3, 0 where the curve stops.
+template<typename T>
+static inline T Curvature(Vec3T<T> const &firstDerivative, Vec3T<T> const &secondDerivative) {
+    T speed = firstDerivative.length();
+
+    if (speed == 0) {
+        return 0;
+    }
+
+    return Vec3T<T>::cross(firstDerivative, secondDerivative).length() / (speed * speed * speed);
+}
+
+#endif
@@ -1,51 +1,58 @@
 #ifndef VEC3_H
 #define VEC3_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <limits>
 #include <cassert>
+#include <type_traits>
 
-#include <gsl/gsl_matrix.h>
-#include <gsl/gsl_linalg.h>
-// you need to add the following libraries to your project : gsl, gslcblas
+// Keeps a parameter out of template argument deduction, so that 0.5 or 2 can be passed
+// next to a Vec3T<float> without an explicit cast.
+template<typename T>
+struct NonDeduced {
+    typedef T type;
+};
 
-class Vec3 {
+// A plain value: trivially copyable and standard layout, three packed scalars (checked below),
+// so arrays of Vec3T can be memcpy'd, written to files or GL buffers and read back as they are.
+// The default constructor leaves the coordinates uninitialized like a float would, Vec3T() zeroes them.
+template<typename T>
+class Vec3T {
 private:
-    float mVals[3];
+    T mVals[3];
 public:
-    Vec3() {}
+    typedef T Scalar;
 
-    Vec3(float x, float y, float z) {
-        mVals[0] = x;
-        mVals[1] = y;
-        mVals[2] = z;
-    }
+    Vec3T() = default;
 
-    float &operator[](unsigned int c) { return mVals[c]; }
+    constexpr Vec3T(T x, T y, T z) : mVals{x, y, z} {}
 
-    float operator[](unsigned int c) const { return mVals[c]; }
+    // Explicit, so that precision never changes behind the caller's back
+    template<typename U>
+    constexpr explicit Vec3T(Vec3T<U> const &other) : mVals{(T) other[0], (T) other[1], (T) other[2]} {}
 
-    void operator=(Vec3 const &other) {
-        mVals[0] = other[0];
-        mVals[1] = other[1];
-        mVals[2] = other[2];
-    }
+    constexpr T &operator[](unsigned int c) { return mVals[c]; }
+
+    constexpr T operator[](unsigned int c) const { return mVals[c]; }
 
-    float squareLength() const {
+    constexpr T squareLength() const {
         return mVals[0] * mVals[0] + mVals[1] * mVals[1] + mVals[2] * mVals[2];
     }
 
-    float length() const { return sqrt(squareLength()); }
+    T length() const { return std::sqrt(squareLength()); }
 
     void normalize() {
-        float L = length();
+        T L = length();
         mVals[0] /= L;
         mVals[1] /= L;
         mVals[2] /= L;
     }
 
-    static float dot(Vec3 const &a, Vec3 const &b) {
-        float res = 0;
+    static constexpr T dot(Vec3T const &a, Vec3T const &b) {
+        T res = 0;
 
         for (int i = 0; i < 3; i++) {
             res += a[i] * b[i];
@@ -54,61 +61,89 @@ public:
         return res;
     }
 
-    static Vec3 cross(Vec3 const &a, Vec3 const &b) {
-        return Vec3(
+    static constexpr Vec3T cross(Vec3T const &a, Vec3T const &b) {
+        return Vec3T(
                 a[1]*b[2] - a[2]*b[1],
                 a[2]*b[0] - a[0]*b[2],
                 a[0]*b[1] - a[1]*b[0]
         );
     }
 
-    void operator+=(Vec3 const &other) {
+    // Fused kernels, one expression per coordinate so that chains such as a de Casteljau level keep
+    // no Vec3 temporary. lerp rounds like (b - a) * u + a, the order used by the Simd/ kernels.
+    static constexpr Vec3T lerp(Vec3T const &a, Vec3T const &b, T u) {
+        return Vec3T(a[0] + (b[0] - a[0]) * u, a[1] + (b[1] - a[1]) * u, a[2] + (b[2] - a[2]) * u);
+    }
+
+    // s a + b
+    static constexpr Vec3T axpy(T s, Vec3T const &a, Vec3T const &b) {
+        return Vec3T(s * a[0] + b[0], s * a[1] + b[1], s * a[2] + b[2]);
+    }
+
+    void operator+=(Vec3T const &other) {
         mVals[0] += other[0];
         mVals[1] += other[1];
         mVals[2] += other[2];
     }
 
-    void operator-=(Vec3 const &other) {
+    void operator-=(Vec3T const &other) {
         mVals[0] -= other[0];
         mVals[1] -= other[1];
         mVals[2] -= other[2];
     }
 
-    void operator*=(float s) {
+    void operator*=(T s) {
         mVals[0] *= s;
         mVals[1] *= s;
         mVals[2] *= s;
     }
 
-    void operator/=(float s) {
+    void operator/=(T s) {
         mVals[0] /= s;
         mVals[1] /= s;
         mVals[2] /= s;
     }
 };
 
-static inline Vec3 operator+(Vec3 const &a, Vec3 const &b) {
-    return Vec3(a[0] + b[0], a[1] + b[1], a[2] + b[2]);
+typedef Vec3T<float> Vec3;
+typedef Vec3T<double> Vec3d;
+typedef Vec3T<long double> Vec3ld;
+
+static_assert(std::is_trivially_copyable<Vec3>::value && std::is_trivially_copyable<Vec3d>::value,
+              "Vec3 is copied with memcpy and read from binary files");
+static_assert(std::is_standard_layout<Vec3>::value && std::is_standard_layout<Vec3d>::value,
+              "Vec3 is read as three consecutive scalars");
+static_assert(sizeof(Vec3) == 3 * sizeof(float) && sizeof(Vec3d) == 3 * sizeof(double),
+              "Vec3 must not be padded");
+
+template<typename T>
+static inline constexpr Vec3T<T> operator+(Vec3T<T> const &a, Vec3T<T> const &b) {
+    return Vec3T<T>(a[0] + b[0], a[1] + b[1], a[2] + b[2]);
 }
 
-static inline Vec3 operator-(Vec3 const &a, Vec3 const &b) {
-    return Vec3(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
+template<typename T>
+static inline constexpr Vec3T<T> operator-(Vec3T<T> const &a, Vec3T<T> const &b) {
+    return Vec3T<T>(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
 }
 
-static inline Vec3 operator*(float a, Vec3 const &b) {
-    return Vec3(a * b[0], a * b[1], a * b[2]);
+template<typename T>
+static inline constexpr Vec3T<T> operator*(typename NonDeduced<T>::type a, Vec3T<T> const &b) {
+    return Vec3T<T>(a * b[0], a * b[1], a * b[2]);
 }
 
-static inline Vec3 operator/(Vec3 const &a, float b) {
-    return Vec3(a[0] / b, a[1] / b, a[2] / b);
+template<typename T>
+static inline constexpr Vec3T<T> operator/(Vec3T<T> const &a, typename NonDeduced<T>::type b) {
+    return Vec3T<T>(a[0] / b, a[1] / b, a[2] / b);
 }
 
-static inline std::ostream &operator<<(std::ostream &s, Vec3 const &p) {
+template<typename T>
+static inline std::ostream &operator<<(std::ostream &s, Vec3T<T> const &p) {
     s << p[0] << " " << p[1] << " " << p[2];
     return s;
 }
 
-static inline std::istream &operator>>(std::istream &s, Vec3 &p) {
+template<typename T>
+static inline std::istream &operator>>(std::istream &s, Vec3T<T> &p) {
     s >> p[0] >> p[1] >> p[2];
     return s;
 }
@@ -116,49 +151,30 @@ static inline std::istream &operator>>(std::istream &s, Vec3 &p) {
 class Mat3 {
 public:
     ////////////         CONSTRUCTORS          //////////////
-    Mat3() {
-        vals[0] = 0;
-        vals[1] = 0;
-        vals[2] = 0;
-        vals[3] = 0;
-        vals[4] = 0;
-        vals[5] = 0;
-        vals[6] = 0;
-        vals[7] = 0;
-        vals[8] = 0;
-    }
-
-    Mat3(float v1, float v2, float v3, float v4, float v5, float v6, float v7, float v8, float v9) {
-        vals[0] = v1;
-        vals[1] = v2;
-        vals[2] = v3;
-        vals[3] = v4;
-        vals[4] = v5;
-        vals[5] = v6;
-        vals[6] = v7;
-        vals[7] = v8;
-        vals[8] = v9;
-    }
-
-    Mat3(const Mat3 &m) {
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                (*this)(i, j) = m(i, j);
-    }
+    // Copies are the implicit ones: Mat3 is trivially copyable, 9 packed floats (checked below)
+    constexpr Mat3() : vals{0, 0, 0, 0, 0, 0, 0, 0, 0} {}
 
+    constexpr Mat3(float v1, float v2, float v3, float v4, float v5, float v6, float v7, float v8, float v9)
+            : vals{v1, v2, v3, v4, v5, v6, v7, v8, v9} {}
 
-    Vec3 operator*(const Vec3 &p) // computes m.p
-    {
-        //Fonction à completer
-        //Pour acceder a un element de la matrice (*this)(i,j) et du point p[i]
-        return Vec3(); //A remplacer par le résultat de la multiplication
+    // computes m.p, each row summed from left to right (TransformPoints rounds the same way)
+    constexpr Vec3 operator*(const Vec3 &p) const {
+        return Vec3(vals[0] * p[0] + vals[1] * p[1] + vals[2] * p[2],
+                    vals[3] * p[0] + vals[4] * p[1] + vals[5] * p[2],
+                    vals[6] * p[0] + vals[7] * p[1] + vals[8] * p[2]);
     }
 
-    Mat3 operator*(const Mat3 &m2) {
-        //Fonction à completer
-        //Pour acceder a un element de la premiere matrice (*this)(i,j) et de la deuxième m2(k,l)
-
-        return Mat3(); //A remplacer par le résultat de la multiplication
+    // computes m.m2, applying m2 first
+    constexpr Mat3 operator*(const Mat3 &m2) const {
+        return Mat3(vals[0] * m2.vals[0] + vals[1] * m2.vals[3] + vals[2] * m2.vals[6],
+                    vals[0] * m2.vals[1] + vals[1] * m2.vals[4] + vals[2] * m2.vals[7],
+                    vals[0] * m2.vals[2] + vals[1] * m2.vals[5] + vals[2] * m2.vals[8],
+                    vals[3] * m2.vals[0] + vals[4] * m2.vals[3] + vals[5] * m2.vals[6],
+                    vals[3] * m2.vals[1] + vals[4] * m2.vals[4] + vals[5] * m2.vals[7],
+                    vals[3] * m2.vals[2] + vals[4] * m2.vals[5] + vals[5] * m2.vals[8],
+                    vals[6] * m2.vals[0] + vals[7] * m2.vals[3] + vals[8] * m2.vals[6],
+                    vals[6] * m2.vals[1] + vals[7] * m2.vals[4] + vals[8] * m2.vals[7],
+                    vals[6] * m2.vals[2] + vals[7] * m2.vals[5] + vals[8] * m2.vals[8]);
     }
 
     bool isnan() const {
@@ -167,12 +183,6 @@ public:
                || std::isnan(vals[6]) || std::isnan(vals[7]) || std::isnan(vals[8]);
     }
 
-    void operator=(const Mat3 &m) {
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                (*this)(i, j) = m(i, j);
-    }
-
     void operator+=(const Mat3 &m) {
         for (int i = 0; i < 3; ++i)
             for (int j = 0; j < 3; ++j)
@@ -213,9 +223,9 @@ public:
     }
 
     ////////        ACCESS TO COORDINATES      /////////
-    float operator()(unsigned int i, unsigned int j) const { return vals[3 * i + j]; }
+    constexpr float operator()(unsigned int i, unsigned int j) const { return vals[3 * i + j]; }
 
-    float &operator()(unsigned int i, unsigned int j) { return vals[3 * i + j]; }
+    constexpr float &operator()(unsigned int i, unsigned int j) { return vals[3 * i + j]; }
 
     ////////        BASICS       /////////
     inline float sqrnorm() {
@@ -251,44 +261,132 @@ public:
         float sz;
         Mat3 Vt;
         m.SVD(U, sx, sy, sz, Vt);
-        float sxInv = sx == 0.0 ? 1.0 / sx : defaultValueForInverseSingularValue;
-        float syInv = sy == 0.0 ? 1.0 / sy : defaultValueForInverseSingularValue;
-        float szInv = sz == 0.0 ? 1.0 / sz : defaultValueForInverseSingularValue;
+
+        // The rank is that of the float matrix: values within rounding of sx are zero, not exactly 0
+        float threshold = 3 * std::numeric_limits<float>::epsilon() * sx;
+        float sxInv = sx > threshold ? 1.0 / sx : defaultValueForInverseSingularValue;
+        float syInv = sy > threshold ? 1.0 / sy : defaultValueForInverseSingularValue;
+        float szInv = sz > threshold ? 1.0 / sz : defaultValueForInverseSingularValue;
         return Vt.getTranspose() * Mat3::diag(sxInv, syInv, szInv) * U.getTranspose();
     }
 
+    // One sided Jacobi, in double and on the stack: rotations V make the columns of B = A V
+    // orthogonal, then B = U Sigma. sx >= sy >= sz >= 0, U and V orthonormal.
     void SVD(Mat3 &U, float &sx, float &sy, float &sz, Mat3 &Vt) const {
-        gsl_matrix *u = gsl_matrix_alloc(3, 3);
-        for (unsigned int i = 0; i < 3; ++i)
-            for (unsigned int j = 0; j < 3; ++j)
-                gsl_matrix_set(u, i, j, (*this)(i, j));
-
-        gsl_matrix *v = gsl_matrix_alloc(3, 3);
-        gsl_vector *s = gsl_vector_alloc(3);
-        gsl_vector *work = gsl_vector_alloc(3);
-
-        gsl_linalg_SV_decomp(u,
-                             v,
-                             s,
-                             work);
-
-        sx = s->data[0];
-        sy = s->data[1];
-        sz = s->data[2];
+        double b[3][3];
+        double v[3][3];
+
         for (unsigned int i = 0; i < 3; ++i) {
             for (unsigned int j = 0; j < 3; ++j) {
-                U(i, j) = gsl_matrix_get(u, i, j);
-                Vt(i, j) = gsl_matrix_get(v, j, i);
+                b[i][j] = (*this)(i, j);
+                v[i][j] = i == j ? 1.0 : 0.0;
+            }
+        }
+
+        // Converges quadratically, in 4 to 6 sweeps, the bound only guards against NaN
+        for (int sweep = 0; sweep < 32; ++sweep) {
+            bool rotated = false;
+
+            for (int p = 0; p < 2; ++p) {
+                for (int q = p + 1; q < 3; ++q) {
+                    double alpha = 0.0;
+                    double beta = 0.0;
+                    double gamma = 0.0;
+
+                    for (int k = 0; k < 3; ++k) {
+                        alpha += b[k][p] * b[k][p];
+                        beta += b[k][q] * b[k][q];
+                        gamma += b[k][p] * b[k][q];
+                    }
+
+                    if (!(std::fabs(gamma) > std::numeric_limits<double>::epsilon() * std::sqrt(alpha * beta))) {
+                        continue;
+                    }
+
+                    // tangent of the rotation angle, the smaller root
+                    double d = beta - alpha;
+                    double t = (d < 0.0 ? -2.0 * gamma : 2.0 * gamma)
+                               / (std::fabs(d) + std::sqrt(d * d + 4.0 * gamma * gamma));
+                    double c = 1.0 / std::sqrt(1.0 + t * t);
+
+                    rotateColumns(b, p, q, c, c * t);
+                    rotateColumns(v, p, q, c, c * t);
+                    rotated = true;
+                }
+            }
+
+            if (!rotated) {
+                break;
+            }
+        }
+
+        double sigma[3];
+        int order[3] = {0, 1, 2};
+
+        for (int j = 0; j < 3; ++j) {
+            sigma[j] = std::sqrt(b[0][j] * b[0][j] + b[1][j] * b[1][j] + b[2][j] * b[2][j]);
+        }
+
+        std::sort(order, order + 3, [&sigma](int i, int j) { return sigma[i] > sigma[j]; });
+
+        double u[3][3];
+
+        // u1 = b1 / s1
+        for (int k = 0; k < 3; ++k) {
+            u[k][0] = sigma[order[0]] > 0.0 ? b[k][order[0]] / sigma[order[0]] : (k == 0 ? 1.0 : 0.0);
+        }
+
+        // u2 = b2 made orthogonal to u1, any unit vector orthogonal to u1 when the rank is 1
+        double projection = u[0][0] * b[0][order[1]] + u[1][0] * b[1][order[1]] + u[2][0] * b[2][order[1]];
+        double w[3];
+
+        for (int k = 0; k < 3; ++k) {
+            w[k] = b[k][order[1]] - projection * u[k][0];
+        }
+
+        double wLength = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+
+        if (!(wLength > 8 * std::numeric_limits<float>::epsilon() * sigma[order[0]])) {
+            if (u[0][0] * u[0][0] < u[1][0] * u[1][0]) {
+                w[0] = 0.0;
+                w[1] = u[2][0];
+                w[2] = -u[1][0];
+            } else {
+                w[0] = -u[2][0];
+                w[1] = 0.0;
+                w[2] = u[0][0];
+            }
+
+            wLength = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        }
+
+        for (int k = 0; k < 3; ++k) {
+            u[k][1] = w[k] / wLength;
+        }
+
+        // u3 = u1 x u2, oriented like b3
+        u[0][2] = u[1][0] * u[2][1] - u[2][0] * u[1][1];
+        u[1][2] = u[2][0] * u[0][1] - u[0][0] * u[2][1];
+        u[2][2] = u[0][0] * u[1][1] - u[1][0] * u[0][1];
+
+        if (u[0][2] * b[0][order[2]] + u[1][2] * b[1][order[2]] + u[2][2] * b[2][order[2]] < 0.0) {
+            for (int k = 0; k < 3; ++k) {
+                u[k][2] = -u[k][2];
+            }
+        }
+
+        sx = sigma[order[0]];
+        sy = sigma[order[1]];
+        sz = sigma[order[2]];
+        for (unsigned int i = 0; i < 3; ++i) {
+            for (unsigned int j = 0; j < 3; ++j) {
+                U(i, j) = u[i][j];
+                Vt(i, j) = v[j][order[i]];
             }
         }
         assert(sx >= sy);
         assert(sy >= sz);
 
-        gsl_matrix_free(u);
-        gsl_matrix_free(v);
-        gsl_vector_free(s);
-        gsl_vector_free(work);
-
         // a transformation float is given as R.B.S.Bt, R = rotation , B = local basis (rotation matrix), S = scales in the basis B
         // it can be obtained from the svd decomposition of float = U Sigma Vt :
         // B = V
@@ -333,9 +431,9 @@ public:
     }
 
     // ---------- STATIC STANDARD MATRICES ---------- //
-    inline static Mat3 Identity() { return Mat3(1, 0, 0, 0, 1, 0, 0, 0, 1); }
+    inline static constexpr Mat3 Identity() { return Mat3(1, 0, 0, 0, 1, 0, 0, 0, 1); }
 
-    inline static Mat3 Zero() { return Mat3(0, 0, 0, 0, 0, 0, 0, 0, 0); }
+    inline static constexpr Mat3 Zero() { return Mat3(0, 0, 0, 0, 0, 0, 0, 0, 0); }
 
     template<typename T2>
     inline static Mat3 diag(T2 x, T2 y, T2 z) { return Mat3(x, 0, 0, 0, y, 0, 0, 0, z); }
@@ -367,6 +465,17 @@ public:
 
 
 private:
+    // Columns p and q of m replaced by c p - s q and s p + c q
+    static void rotateColumns(double m[3][3], int p, int q, double c, double s) {
+        for (int k = 0; k < 3; ++k) {
+            double mp = m[k][p];
+            double mq = m[k][q];
+
+            m[k][p] = c * mp - s * mq;
+            m[k][q] = s * mp + c * mq;
+        }
+    }
+
     float vals[9];
     // will be noted as :
     // 0 1 2
@@ -374,6 +483,10 @@ private:
     // 6 7 8
 };
 
+static_assert(std::is_trivially_copyable<Mat3>::value && std::is_standard_layout<Mat3>::value,
+              "Mat3 is copied with memcpy");
+static_assert(sizeof(Mat3) == 9 * sizeof(float), "Mat3 must not be padded");
+
 
 inline static
 Mat3 operator*(float s, const Mat3 &m) {
@@ -0,0 +1,76 @@
+//
+// De Casteljau engine: BezierCurveAdaptive on tp.cpp's curve, against uniform polylines of the same tolerance.
+//
+
+#include <algorithm>
+#include "testing.h"
+#include "../Casteljau/casteljau.h"
+
+// tp.cpp's control polygon, drawn with BezierCurveAdaptive(controlPoints, 1e-3)
+static const std::vector<Vec3> ADAPTIVE_TEST_CURVE = {Vec3(-1, 0, 0), Vec3(-.25f, 1, 0), Vec3(0, -1, 0),
+                                                      Vec3(.25f, 1, 0), Vec3(1, 0, 0)};
+
+static double segmentDistance(const Vec3d &p, const Vec3d &a, const Vec3d &b) {
+    Vec3d ab = b - a;
+    double t = ab.squareLength() > 0 ? Vec3d::dot(p - a, ab) / ab.squareLength() : 0;
+    t = std::min(1.0, std::max(0.0, t));
+
+    return (p - (a + t * ab)).length();
+}
+
+// Largest distance from the curve, sampled densely in double precision, to the polyline
+static double deviation(const std::vector<Vec3> &polyline) {
+    std::vector<Vec3d> controlPoints(ADAPTIVE_TEST_CURVE.begin(), ADAPTIVE_TEST_CURVE.end());
+    std::vector<Vec3d> vertices(polyline.begin(), polyline.end());
+    double worst = 0;
+
+    for (int i = 0; i <= 2000; i++) {
+        Vec3d p = BezierPointByCasteljau(controlPoints, (double) i / 2000.0);
+        double nearest = (p - vertices[0]).length();
+
+        for (size_t s = 0; s + 1 < vertices.size(); s++) {
+            nearest = std::min(nearest, segmentDistance(p, vertices[s], vertices[s + 1]));
+        }
+
+        worst = std::max(worst, nearest);
+    }
+
+    return worst;
+}
+
+// Fixed sampling closed with the u = 1 end point, BezierCurveByCasteljau stops before it
+static std::vector<Vec3> uniformPolyline(long nbU) {
+    std::vector<Vec3> polyline = BezierCurveByCasteljau(ADAPTIVE_TEST_CURVE, nbU);
+    polyline.push_back(ADAPTIVE_TEST_CURVE.back());
+
+    return polyline;
+}
+
+// On this curve subdivision by halves does not save vertices over the best uniform sampling, found
+// here by trying every nbU: 19 against 16 at 1e-2, 47 against 48 at 1e-3, 165 against 149 at 1e-4.
+// What it gives is the tolerance without searching for nbU, at a bounded cost in vertices.
+void TestAdaptiveVertexCount() {
+    for (double tolerance : {1e-2, 1e-3, 1e-4}) {
+        std::vector<Vec3> adaptive = BezierCurveAdaptive(ADAPTIVE_TEST_CURVE, (float) tolerance);
+
+        CHECK(deviation(adaptive) <= tolerance);
+
+        long nbU = 1;
+
+        while (deviation(uniformPolyline(nbU)) > tolerance) {
+            nbU++;
+        }
+
+        CHECK(4 * adaptive.size() <= 5 * uniformPolyline(nbU).size());
+    }
+}
+
+void TestAdaptiveEndpoints() {
+    for (float tolerance : {1e-1f, 1e-3f, 1e-6f}) {
+        std::vector<Vec3> adaptive = BezierCurveAdaptive(ADAPTIVE_TEST_CURVE, tolerance);
+
+        CHECK(adaptive.size() >= 2);
+        CHECK((adaptive.front() - ADAPTIVE_TEST_CURVE.front()).squareLength() == 0);
+        CHECK((adaptive.back() - ADAPTIVE_TEST_CURVE.back()).squareLength() == 0);
+    }
+}
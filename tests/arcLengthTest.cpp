@@ -0,0 +1,68 @@
+//
+// Arc-length tables: exact lengths of straight lines, and parameterAt inverting lengthAt.
+//
+
+#include <vector>
+#include "testing.h"
+#include "../ArcLength/arcLength.h"
+
+// A few double roundings of lengths below 10
+static const double ARC_LENGTH_TEST_EXACT_TOLERANCE = 1e-13;
+
+// Two Newton steps on lengths near 4, in float and in double
+static const double ARC_LENGTH_TEST_FLOAT_TOLERANCE = 2e-5;
+static const double ARC_LENGTH_TEST_DOUBLE_TOLERANCE = 1e-10;
+
+// A cubic along a straight line, its control points unevenly spaced but in order: the hodograph keeps
+// its direction, the speed is a degree 2 polynomial and the quadrature is exact.
+void TestArcLengthStraightLine() {
+    const Vec3T<double> direction(2.0 / 7.0, 3.0 / 7.0, 6.0 / 7.0);
+    const std::vector<Vec3T<double> > controlPoints = {
+            Vec3T<double>(1, -1, 0.5),
+            Vec3T<double>(1, -1, 0.5) + 1.0 * direction,
+            Vec3T<double>(1, -1, 0.5) + 1.5 * direction,
+            Vec3T<double>(1, -1, 0.5) + 3.0 * direction
+    };
+
+    ArcLengthTableT<double> table(controlPoints);
+
+    CHECK_NEAR(table.length(), 3.0, ARC_LENGTH_TEST_EXACT_TOLERANCE);
+
+    for (int i = 0; i <= 10; i++) {
+        double u = i / 10.0;
+
+        // Distance along the line from the first control point
+        CHECK_NEAR(table.lengthAt(u), (table.point(u) - controlPoints[0]).length(), ARC_LENGTH_TEST_EXACT_TOLERANCE);
+    }
+
+    // Hermite form of a line, the tangents along it: Bezier points at 0, 1, 3 and 7 along direction
+    ArcLengthTableT<double> hermite(Vec3T<double>(0, 0, 0), 7.0 * direction, 3.0 * direction, 12.0 * direction);
+
+    CHECK_NEAR(hermite.length(), 7.0, ARC_LENGTH_TEST_EXACT_TOLERANCE);
+}
+
+template<typename T>
+static void checkRoundTrip(const std::vector<Vec3T<T> > &controlPoints, double tolerance) {
+    ArcLengthTableT<T> table(controlPoints);
+
+    for (int i = 0; i <= 200; i++) {
+        T s = table.length() * (T) i / (T) 200;
+
+        CHECK_NEAR(table.lengthAt(table.parameterAt(s)), s, tolerance);
+    }
+}
+
+// lengthAt(parameterAt(s)) = s on tp.cpp's curve, whose speed varies a lot along u
+void TestArcLengthRoundTrip() {
+    const std::vector<Vec3> controlPoints = {
+            Vec3(-1, 0, 0), Vec3(-.25f, 1, 0), Vec3(0, -1, 0), Vec3(.25f, 1, 0), Vec3(1, 0, 0)
+    };
+    std::vector<Vec3T<double> > controlPointsDouble;
+
+    for (const Vec3 &p : controlPoints) {
+        controlPointsDouble.push_back(Vec3T<double>(p));
+    }
+
+    checkRoundTrip(controlPoints, ARC_LENGTH_TEST_FLOAT_TOLERANCE);
+    checkRoundTrip(controlPointsDouble, ARC_LENGTH_TEST_DOUBLE_TOLERANCE);
+}
@@ -0,0 +1,77 @@
+//
+// Bernstein basis cache: hit and miss counters, LRU eviction and the memory budget.
+//
+
+#include "testing.h"
+#include "../Berstein/basisCache.h"
+#include "../Berstein/berstein.h"
+
+static size_t tableBytes(unsigned long degree, long nbU) {
+    return (size_t) nbU * (degree + 1) * sizeof(float);
+}
+
+void TestBasisCacheCounters() {
+    BernsteinBasisCache cache;
+
+    std::shared_ptr<const BasisMatrix> first = cache.basisMatrix(3, 100);
+    std::shared_ptr<const BasisMatrix> second = cache.basisMatrix(3, 100);
+    cache.basisMatrix(4, 100);
+
+    CHECK(cache.misses() == 2);
+    CHECK(cache.hits() == 1);
+    CHECK(first == second);
+    CHECK(first->size() == 100 * 4);
+    CHECK(cache.memoryUsed() == tableBytes(3, 100) + tableBytes(4, 100));
+
+    // Row i holds the basis at u = i / nbU
+    std::vector<double> basis(4);
+    BernsteinBasis(3, 0.25f, basis.data());
+
+    for (int j = 0; j < 4; j++) {
+        CHECK((*first)[25 * 4 + j] == (float) basis[j]);
+    }
+
+    cache.clear();
+
+    CHECK(cache.hits() == 0 && cache.misses() == 0 && cache.memoryUsed() == 0);
+}
+
+void TestBasisCacheEviction() {
+    // Room for two tables of degree 3 at nbU 100, not three
+    BernsteinBasisCache cache(2 * tableBytes(3, 100) + tableBytes(3, 100) / 2);
+
+    cache.basisMatrix(3, 100);
+    cache.basisMatrix(3, 101);
+
+    // The first table becomes the most recently used, so the second one goes
+    cache.basisMatrix(3, 100);
+    cache.basisMatrix(3, 99);
+
+    CHECK(cache.memoryUsed() == tableBytes(3, 100) + tableBytes(3, 99));
+    CHECK(cache.memoryUsed() <= cache.memoryBudget());
+
+    unsigned long misses = cache.misses();
+
+    cache.basisMatrix(3, 100);
+    CHECK(cache.misses() == misses);
+
+    cache.basisMatrix(3, 101);
+    CHECK(cache.misses() == misses + 1);
+}
+
+void TestBasisCacheOverBudget() {
+    BernsteinBasisCache cache(tableBytes(3, 100));
+
+    std::shared_ptr<const BasisMatrix> small = cache.basisMatrix(3, 100);
+    std::shared_ptr<const BasisMatrix> large = cache.basisMatrix(3, 1000);
+
+    // Returned whole, but not stored and without evicting what fits
+    CHECK(large->size() == 1000 * 4);
+    CHECK(cache.memoryUsed() == tableBytes(3, 100));
+
+    cache.basisMatrix(3, 1000);
+    CHECK(cache.misses() == 3);
+
+    cache.basisMatrix(3, 100);
+    CHECK(cache.hits() == 1);
+}
@@ -0,0 +1,128 @@
+//
+// Batch tessellation: malformed entries and sample counts.
+//
+
+#include <cmath>
+#include <cstring>
+#include "testing.h"
+#include "../Batch/batch.h"
+#include "../Berstein/berstein.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+
+void TestBatchMalformedHermite() {
+    CurveBatch curves;
+    std::vector<Vec3> hermite = {Vec3(0, 0, 0), Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, -1, 0)};
+
+    curves.addCurve(hermite);
+    curves.addCurve(std::vector<Vec3>(hermite.begin(), hermite.begin() + 3));
+    curves.addCurve(std::vector<Vec3>());
+    curves.addCurve(hermite);
+
+    ThreadPool pool(2);
+    TessellatedBatch batch = TessellateBatch(curves, ENGINE_HERMITE, 8, pool);
+
+    CHECK(batch.points.size() == 32);
+
+    // The 3 point entry is zero filled like the empty one, its neighbours are untouched
+    for (size_t i = batch.offsets[1]; i < batch.offsets[3]; i++) {
+        CHECK(batch.points[i].squareLength() == 0);
+    }
+
+    for (long i = 0; i < 8; i++) {
+        Vec3 expected = HermiteCubicPoint(hermite[0], hermite[1], hermite[2], hermite[3], (float) i / 8.0f);
+
+        CHECK((batch.points[batch.offsets[0] + i] - expected).squareLength() == 0);
+        CHECK((batch.points[batch.offsets[3] + i] - expected).squareLength() == 0);
+    }
+}
+
+void TestBatchNonPositiveNbU() {
+    CurveBatch curves;
+    curves.addCurve({Vec3(0, 0, 0), Vec3(1, 1, 0), Vec3(2, 0, 0)});
+    curves.addCurve({Vec3(0, 0, 0), Vec3(1, 0, 1)});
+
+    ThreadPool pool(2);
+
+    for (long nbU : {0L, -1L, -1000L}) {
+        TessellatedBatch batch = TessellateBatch(curves, ENGINE_CASTELJAU, nbU, pool);
+
+        CHECK(batch.points.empty());
+        CHECK(batch.offsets.size() == 3);
+        CHECK(batch.offsets.back() == 0);
+    }
+}
+
+// Serial evaluation of curve c with the engine's own per curve function
+static std::vector<Vec3> serialCurve(const CurveBatch &curves, size_t c, CurveEngine engine, long nbU) {
+    std::vector<Vec3> controlPoints(curves.points.begin() + curves.offsets[c],
+                                    curves.points.begin() + curves.offsets[c + 1]);
+
+    if (controlPoints.empty() || (engine == ENGINE_HERMITE && controlPoints.size() != 4)) {
+        return std::vector<Vec3>(nbU, Vec3(0, 0, 0));
+    }
+
+    switch (engine) {
+        case ENGINE_CASTELJAU:
+            return BezierCurveByCasteljau(controlPoints, nbU);
+        case ENGINE_BERNSTEIN:
+            return BezierCurveByBernstein(controlPoints, nbU);
+        case ENGINE_HERMITE:
+            break;
+    }
+
+    std::vector<Vec3> samples(nbU);
+
+    for (long i = 0; i < nbU; i++) {
+        samples[i] = HermiteCubicPoint(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3],
+                                       (float) i / (float) nbU);
+    }
+
+    return samples;
+}
+
+void TestBatchParallelMatchesSerial() {
+    const size_t nbCurves = 1000;
+    const long nbU = 17;
+
+    // Many grains of BATCH_GRAIN curves, of every size from empty to past the de Casteljau stack
+    // polygon, with a malformed Hermite entry now and then
+    CurveBatch curves;
+
+    for (size_t c = 0; c < nbCurves; c++) {
+        size_t nbPoints = c % 7 == 0 ? 4 : c % 23;
+        std::vector<Vec3> controlPoints(nbPoints);
+
+        for (size_t i = 0; i < nbPoints; i++) {
+            controlPoints[i] = Vec3(std::sin(0.1f * c + i), std::cos(0.3f * c * i), 0.01f * c);
+        }
+
+        curves.addCurve(controlPoints);
+    }
+
+    ThreadPool pool(4);
+
+    for (CurveEngine engine : {ENGINE_CASTELJAU, ENGINE_BERNSTEIN, ENGINE_HERMITE}) {
+        TessellatedBatch batch = TessellateBatch(curves, engine, nbU, pool);
+
+        CHECK(batch.offsets.size() == nbCurves + 1);
+        CHECK(batch.points.size() == nbCurves * nbU);
+
+        bool sized = batch.offsets.size() == nbCurves + 1 && batch.points.size() == nbCurves * nbU;
+
+        for (size_t c = 0; sized && c < nbCurves; c++) {
+            std::vector<Vec3> expected = serialCurve(curves, c, engine, nbU);
+
+            CHECK(batch.offsets[c] == c * nbU);
+            CHECK(std::memcmp(batch.points.data() + batch.offsets[c], expected.data(), nbU * sizeof(Vec3)) == 0);
+        }
+
+        // Same bits whatever the order the grains ran in
+        for (int run = 0; run < 3; run++) {
+            TessellatedBatch again = TessellateBatch(curves, engine, nbU, pool);
+
+            CHECK(again.offsets == batch.offsets);
+            CHECK(std::memcmp(again.points.data(), batch.points.data(), batch.points.size() * sizeof(Vec3)) == 0);
+        }
+    }
+}
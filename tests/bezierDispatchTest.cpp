@@ -0,0 +1,36 @@
+//
+// Degree dispatch: the specialized BezierCurve<N> paths against the generic de Casteljau, bitwise.
+//
+
+#include <cmath>
+#include <cstring>
+#include "testing.h"
+#include "../Bezier/bezierDispatch.h"
+#include "../Casteljau/casteljau.h"
+
+void TestBezierDispatchMatchesCasteljau() {
+    // Degree 0 and degrees above BEZIER_MAX_SPECIALIZED_DEGREE take the generic fallback
+    for (size_t degree = 0; degree <= 9; degree++) {
+        std::vector<Vec3> controlPoints(degree + 1);
+
+        for (size_t i = 0; i <= degree; i++) {
+            controlPoints[i] = Vec3(std::sin(1.1f * i), 0.3f * i, std::cos(2.3f * i));
+        }
+
+        for (long nbU : {1L, 7L, 250L}) {
+            std::vector<Vec3> expected = BezierCurveByCasteljau(controlPoints, nbU);
+            std::vector<Vec3> curve = BezierCurveByDegree(controlPoints, nbU);
+
+            CHECK(curve.size() == expected.size());
+            CHECK(std::memcmp(curve.data(), expected.data(), expected.size() * sizeof(Vec3)) == 0);
+
+            for (long i = 0; i < nbU; i++) {
+                float u = (float) i / (float) nbU;
+                Vec3 point = BezierPointByDegree(controlPoints, u);
+                Vec3 expectedPoint = BezierPointByCasteljau(controlPoints, u);
+
+                CHECK(std::memcmp(&point, &expectedPoint, sizeof(Vec3)) == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+//
+// Exact bounding boxes: against dense samples for every degree, and BezierCurve<N>'s cached box.
+//
+
+#include <algorithm>
+#include <random>
+#include "testing.h"
+#include "../Bounds/bounds.h"
+#include "../Bezier/bezierCurve.h"
+#include "../Casteljau/casteljau.h"
+
+typedef Vec3T<double> Vec3d;
+
+static const int BOUNDS_TEST_SAMPLES = 20000;
+
+// Samples miss an extremum by a second order term in their spacing, roots are bisected to 1e-14
+static const double BOUNDS_TEST_TOLERANCE = 1e-7;
+
+// box holds every dense sample, and each of its faces comes within tolerance of one
+static void checkBox(const AABBT<double> &box, const std::vector<Vec3d> &controlPoints) {
+    AABBT<double> samples;
+
+    for (int i = 0; i <= BOUNDS_TEST_SAMPLES; i++) {
+        samples.extend(BezierPointByCasteljau(controlPoints, (double) i / BOUNDS_TEST_SAMPLES));
+    }
+
+    for (unsigned int c = 0; c < 3; c++) {
+        CHECK(box.min[c] <= samples.min[c] + 1e-14);
+        CHECK(box.max[c] >= samples.max[c] - 1e-14);
+        CHECK_NEAR(box.min[c], samples.min[c], BOUNDS_TEST_TOLERANCE);
+        CHECK_NEAR(box.max[c], samples.max[c], BOUNDS_TEST_TOLERANCE);
+    }
+}
+
+// Degrees 1 to 9, closed form up to cubic and subdivision above
+void TestBoundsMatchDenseSamples() {
+    std::mt19937 generator(18);
+    std::uniform_real_distribution<double> coordinate(-1, 1);
+
+    for (size_t degree = 1; degree <= 9; degree++) {
+        for (int n = 0; n < 20; n++) {
+            std::vector<Vec3d> controlPoints(degree + 1);
+
+            for (Vec3d &p : controlPoints) {
+                p = Vec3d(coordinate(generator), coordinate(generator), coordinate(generator));
+            }
+
+            checkBox(BezierBounds(controlPoints), controlPoints);
+        }
+    }
+}
+
+template<int N>
+static void checkCachedBounds(std::mt19937 &generator) {
+    std::uniform_real_distribution<double> coordinate(-1, 1);
+    Vec3d points[N + 1];
+
+    for (Vec3d &p : points) {
+        p = Vec3d(coordinate(generator), coordinate(generator), coordinate(generator));
+    }
+
+    BezierCurve<N, double> curve(points);
+    std::vector<Vec3d> controlPoints(points, points + N + 1);
+
+    checkBox(curve.bounds(), controlPoints);
+
+    // A point moved far out must grow the cached box, then the last point moved inside shrink it
+    const int moved[2] = {1, N};
+    const Vec3d positions[2] = {Vec3d(5, -5, 5), Vec3d(0, 0, 0)};
+
+    for (int k = 0; k < 2; k++) {
+        controlPoints[moved[k]] = positions[k];
+        curve.setControlPoint(moved[k], positions[k]);
+
+        const AABBT<double> &box = curve.bounds();
+        AABBT<double> expected = BezierBounds(controlPoints);
+
+        checkBox(box, controlPoints);
+
+        for (unsigned int c = 0; c < 3; c++) {
+            CHECK(box.min[c] == expected.min[c]);
+            CHECK(box.max[c] == expected.max[c]);
+        }
+    }
+}
+
+void TestBoundsCacheInvalidation() {
+    std::mt19937 generator(81);
+
+    checkCachedBounds<1>(generator);
+    checkCachedBounds<2>(generator);
+    checkCachedBounds<3>(generator);
+    checkCachedBounds<5>(generator);
+    checkCachedBounds<7>(generator);
+}
@@ -0,0 +1,154 @@
+//
+// B-splines and NURBS: knot insertion and Bezier extraction leave the curve unchanged.
+//
+
+#include <algorithm>
+#include <random>
+#include "testing.h"
+#include "../BSpline/bspline.h"
+#include "../Casteljau/casteljau.h"
+#include "../Rational/rationalBezier.h"
+
+typedef Vec3T<double> Vec3d;
+
+// Samples of the parameter domain per check
+static const int BSPLINE_TEST_SAMPLES = 200;
+
+// A few double roundings per de Casteljau or de Boor level, coordinates below 1
+static const double BSPLINE_TEST_TOLERANCE = 1e-14;
+
+// Float curve() against float de Boor, both a few roundings away from the curve
+static const double BSPLINE_TEST_FLOAT_TOLERANCE = 2e-6;
+
+// degree + 5 control points, clamped knots with 0.45 repeated twice
+template<typename T>
+static BSplineT<T> testSpline(size_t degree, bool rational, std::mt19937 &generator) {
+    std::uniform_real_distribution<double> coordinate(-1, 1);
+    std::uniform_real_distribution<double> weight(0.5, 2);
+    std::vector<Vec3T<T> > controlPoints(degree + 5);
+    std::vector<T> weights;
+
+    for (Vec3T<T> &p : controlPoints) {
+        p = Vec3T<T>((T) coordinate(generator), (T) coordinate(generator), (T) coordinate(generator));
+        weights.push_back((T) weight(generator));
+    }
+
+    std::vector<T> knots(degree + 1, 0);
+    const T interior[4] = {(T) 0.2, (T) 0.45, (T) 0.45, (T) 0.8};
+
+    knots.insert(knots.end(), interior, interior + 4);
+    knots.insert(knots.end(), degree + 1, 1);
+
+    if (rational) {
+        return BSplineT<T>(degree, controlPoints, knots, weights);
+    }
+
+    return BSplineT<T>(degree, controlPoints, knots);
+}
+
+static double maxDistance(const BSplineT<double> &a, const BSplineT<double> &b) {
+    double distance = 0;
+
+    for (int i = 0; i <= BSPLINE_TEST_SAMPLES; i++) {
+        double t = (double) i / BSPLINE_TEST_SAMPLES;
+
+        distance = std::max(distance, (a.point(t) - b.point(t)).length());
+    }
+
+    return distance;
+}
+
+void TestBSplineInsertKnot() {
+    std::mt19937 generator(20);
+
+    for (size_t degree = 1; degree <= 5; degree++) {
+        for (bool rational : {false, true}) {
+            BSplineT<double> spline = testSpline<double>(degree, rational, generator);
+
+            // Inside a span, on the repeated knot, on a single knot, next to both ends
+            for (double t : {0.3, 0.45, 0.8, 0.01, 0.99}) {
+                BSplineT<double> refined = spline;
+                refined.insertKnot(t);
+
+                CHECK(refined.controlPoints().size() == spline.controlPoints().size() + 1);
+                CHECK(refined.knots().size() == spline.knots().size() + 1);
+                CHECK(std::is_sorted(refined.knots().begin(), refined.knots().end()));
+                CHECK_NEAR(maxDistance(spline, refined), 0, BSPLINE_TEST_TOLERANCE);
+            }
+        }
+    }
+}
+
+void TestBSplineBezierSegments() {
+    std::mt19937 generator(21);
+
+    for (size_t degree = 1; degree <= 5; degree++) {
+        for (bool rational : {false, true}) {
+            BSplineT<double> spline = testSpline<double>(degree, rational, generator);
+            BezierSegmentsT<double> segments = spline.bezierSegments();
+            size_t count = degree + 1;
+
+            // One segment per distinct interior knot interval: 0, 0.2, 0.45, 0.8, 1
+            CHECK(segments.size() == 4);
+            CHECK(segments.points.size() == segments.size() * count);
+            CHECK(segments.weights.size() == (rational ? segments.points.size() : 0));
+
+            for (size_t s = 0; s < segments.size(); s++) {
+                std::vector<Vec3d> points(segments.points.begin() + s * count, segments.points.begin() + (s + 1) * count);
+                std::vector<double> weights;
+
+                if (rational) {
+                    weights.assign(segments.weights.begin() + s * count, segments.weights.begin() + (s + 1) * count);
+                }
+
+                // In degree 1 the double knot is a jump, where point() takes the right limit
+                int nbSamples = degree == 1 && s == 1 ? BSPLINE_TEST_SAMPLES - 1 : BSPLINE_TEST_SAMPLES;
+
+                for (int i = 0; i <= nbSamples; i++) {
+                    double u = (double) i / BSPLINE_TEST_SAMPLES;
+                    double t = segments.knots[s] + u * (segments.knots[s + 1] - segments.knots[s]);
+                    Vec3d bezier = rational ? RationalBezierPointByCasteljau(points, weights, u)
+                                            : BezierPointByCasteljau(points, u);
+
+                    CHECK_NEAR((spline.point(t) - bezier).length(), 0, BSPLINE_TEST_TOLERANCE);
+                }
+            }
+        }
+    }
+}
+
+// curve() samples span s at knots[s] + i / nbU of the span, in float through the batch kernels
+template<typename T>
+static void checkCurve(const BSplineT<T> &spline, long nbU, double tolerance) {
+    std::vector<Vec3T<T> > curve = spline.curve(nbU);
+    BezierSegmentsT<T> segments = spline.bezierSegments();
+
+    CHECK(curve.size() == segments.size() * nbU + 1);
+
+    if (curve.size() != segments.size() * nbU + 1) {
+        return;
+    }
+
+    for (size_t s = 0; s < segments.size(); s++) {
+        for (long i = 0; i < nbU; i++) {
+            T t = segments.knots[s] + (T) i / (T) nbU * (segments.knots[s + 1] - segments.knots[s]);
+
+            CHECK_NEAR((curve[s * nbU + i] - spline.point(t)).length(), 0, tolerance);
+        }
+    }
+
+    CHECK_NEAR((curve.back() - spline.controlPoints().back()).length(), 0, tolerance);
+}
+
+void TestBSplineCurve() {
+    std::mt19937 generator(22);
+
+    for (size_t degree = 1; degree <= 5; degree++) {
+        for (bool rational : {false, true}) {
+            checkCurve(testSpline<float>(degree, rational, generator), 13, BSPLINE_TEST_FLOAT_TOLERANCE);
+            checkCurve(testSpline<double>(degree, rational, generator), 13, BSPLINE_TEST_TOLERANCE);
+        }
+    }
+
+    CHECK(testSpline<float>(3, false, generator).curve(0).size() == 1);
+}
@@ -0,0 +1,71 @@
+//
+// De Casteljau engine: heap allocations of BezierCurveByCasteljau.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "testing.h"
+#include "../Casteljau/casteljau.h"
+
+// Every operator new of the process goes through here, counted only between two reads
+static std::atomic<size_t> gAllocations(0);
+
+void *operator new(size_t size) {
+    gAllocations++;
+
+    void *block = std::malloc(size == 0 ? 1 : size);
+
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return block;
+}
+
+void operator delete(void *block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void *block, size_t) noexcept {
+    std::free(block);
+}
+
+static std::vector<Vec3> polygon(size_t nbPoints) {
+    std::vector<Vec3> points(nbPoints);
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        float t = (float) i / (float) nbPoints;
+        points[i] = Vec3(t, std::sin(6 * t), std::cos(3 * t));
+    }
+
+    return points;
+}
+
+static size_t allocationsOf(const std::vector<Vec3> &controlPoints, long nbU) {
+    size_t before = gAllocations;
+    std::vector<Vec3> curve = BezierCurveByCasteljau(controlPoints, nbU);
+    size_t after = gAllocations;
+
+    CHECK(curve.size() == (size_t) nbU);
+
+    return after - before;
+}
+
+void TestCasteljauAllocations() {
+    // Stack buffer: the returned vector is the only allocation, whatever the number of samples
+    for (size_t nbPoints : {(size_t) 2, (size_t) 4, CASTELJAU_STACK_POINTS}) {
+        std::vector<Vec3> controlPoints = polygon(nbPoints);
+
+        CHECK(allocationsOf(controlPoints, 10) == 1);
+        CHECK(allocationsOf(controlPoints, 10000) == 1);
+    }
+
+    // Workspace fallback: one more allocation, made once for the whole curve
+    for (size_t nbPoints : {CASTELJAU_STACK_POINTS + 1, (size_t) 64}) {
+        std::vector<Vec3> controlPoints = polygon(nbPoints);
+
+        CHECK(allocationsOf(controlPoints, 10) == 2);
+        CHECK(allocationsOf(controlPoints, 10000) == 2);
+    }
+}
@@ -0,0 +1,157 @@
+//
+// Closest point index: against a dense search over every curve, for Bezier and Hermite batches.
+//
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include "testing.h"
+#include "../ClosestPoint/closestPoint.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+
+typedef Vec3T<double> Vec3d;
+
+// Samples per curve of the dense search, then again around its best sample
+static const int CLOSEST_POINT_TEST_SAMPLES = 2000;
+
+// Float coordinates below 2, and Newton stopping a few roundings away from the minimum
+static const double CLOSEST_POINT_TEST_TOLERANCE = 1e-4;
+
+static Vec3d curvePoint(const CurveBatch &curves, CurveEngine engine, size_t c, double u) {
+    std::vector<Vec3d> points;
+
+    for (size_t i = curves.offsets[c]; i < curves.offsets[c + 1]; i++) {
+        points.push_back(Vec3d(curves.points[i]));
+    }
+
+    if (engine == ENGINE_HERMITE) {
+        return HermiteCubicPoint(points[0], points[1], points[2], points[3], u);
+    }
+
+    return BezierPointByCasteljau(points, u);
+}
+
+// Distance from point to the nearest curve, in double, skipping what the index should skip
+static double denseDistance(const CurveBatch &curves, CurveEngine engine, const Vec3 &point) {
+    Vec3d p(point);
+    double best = std::numeric_limits<double>::infinity();
+    size_t bestCurve = 0;
+    double bestU = 0;
+
+    for (size_t c = 0; c < curves.size(); c++) {
+        size_t nbPoints = curves.offsets[c + 1] - curves.offsets[c];
+
+        if (nbPoints == 0 || (engine == ENGINE_HERMITE && nbPoints != 4)) {
+            continue;
+        }
+
+        for (int i = 0; i <= CLOSEST_POINT_TEST_SAMPLES; i++) {
+            double u = (double) i / CLOSEST_POINT_TEST_SAMPLES;
+            double distance = (curvePoint(curves, engine, c, u) - p).length();
+
+            if (distance < best) {
+                best = distance;
+                bestCurve = c;
+                bestU = u;
+            }
+        }
+    }
+
+    for (int i = -CLOSEST_POINT_TEST_SAMPLES; i <= CLOSEST_POINT_TEST_SAMPLES; i++) {
+        double u = bestU + (double) i / ((double) CLOSEST_POINT_TEST_SAMPLES * CLOSEST_POINT_TEST_SAMPLES);
+
+        if (u >= 0 && u <= 1) {
+            best = std::min(best, (curvePoint(curves, engine, bestCurve, u) - p).length());
+        }
+    }
+
+    return best;
+}
+
+static void checkIndex(const CurveBatch &curves, CurveEngine engine, const std::vector<Vec3> &queries) {
+    ClosestPointIndex index(curves, engine);
+
+    std::vector<ClosestPoint> batch = index.closestPoints(queries);
+    std::vector<ClosestPoint> pooled(queries.size());
+    ThreadPool pool(4);
+
+    index.closestPoints(queries.data(), queries.size(), pooled.data(), pool);
+
+    for (size_t q = 0; q < queries.size(); q++) {
+        ClosestPoint result = index.closestPoint(queries[q]);
+
+        CHECK(result.curve < curves.size());
+
+        if (result.curve >= curves.size()) {
+            continue;
+        }
+
+        size_t nbPoints = curves.offsets[result.curve + 1] - curves.offsets[result.curve];
+
+        CHECK(engine != ENGINE_HERMITE || nbPoints == 4);
+        CHECK_NEAR(result.distance, denseDistance(curves, engine, queries[q]), CLOSEST_POINT_TEST_TOLERANCE);
+        CHECK_NEAR(result.distance, (result.point - queries[q]).length(), CLOSEST_POINT_TEST_TOLERANCE);
+
+        if (engine != ENGINE_HERMITE || nbPoints == 4) {
+            Vec3d onCurve = curvePoint(curves, engine, result.curve, result.u);
+
+            CHECK_NEAR((onCurve - Vec3d(result.point)).length(), 0, CLOSEST_POINT_TEST_TOLERANCE);
+        }
+
+        // Both batch entry points run the same query
+        for (const ClosestPoint &other : {batch[q], pooled[q]}) {
+            CHECK(other.curve == result.curve);
+            CHECK(other.u == result.u);
+            CHECK(other.distance == result.distance);
+        }
+    }
+}
+
+void TestClosestPointMatchesDenseSearch() {
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> coordinate(-1, 1);
+    std::uniform_real_distribution<float> query(-1.5f, 1.5f);
+
+    std::vector<Vec3> queries;
+
+    for (int n = 0; n < 100; n++) {
+        queries.push_back(Vec3(query(generator), query(generator), query(generator)));
+    }
+
+    // Degrees 1 to 5, and an empty curve
+    CurveBatch bezier;
+
+    for (size_t c = 0; c < 20; c++) {
+        std::vector<Vec3> controlPoints(c == 7 ? 0 : 2 + c % 5);
+
+        for (Vec3 &p : controlPoints) {
+            p = Vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+        }
+
+        bezier.addCurve(controlPoints);
+    }
+
+    checkIndex(bezier, ENGINE_CASTELJAU, queries);
+
+    // p0, p1, v0, v1, and entries of 3 and 5 points that the index skips
+    CurveBatch hermite;
+
+    for (size_t c = 0; c < 20; c++) {
+        std::vector<Vec3> controlPoints(c == 4 ? 3 : c == 11 ? 5 : 4);
+
+        for (Vec3 &p : controlPoints) {
+            p = Vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+        }
+
+        hermite.addCurve(controlPoints);
+    }
+
+    checkIndex(hermite, ENGINE_HERMITE, queries);
+
+    // Nothing but malformed entries: nothing to find
+    CurveBatch malformed;
+    malformed.addCurve(std::vector<Vec3>(3, Vec3(0, 0, 0)));
+
+    CHECK(ClosestPointIndex(malformed, ENGINE_HERMITE).closestPoint(Vec3(1, 1, 1)).curve == NO_CURVE);
+}
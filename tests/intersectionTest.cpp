@@ -0,0 +1,144 @@
+//
+// Curve intersections on cases with known answers, and the broad phase against every pair.
+//
+
+#include <cmath>
+#include <random>
+#include "testing.h"
+#include "../Intersection/intersection.h"
+#include "../Casteljau/casteljau.h"
+
+typedef Vec3T<double> Vec3d;
+
+static const double INTERSECTION_TEST_TOLERANCE = 1e-9;
+
+// Distance between both curves at a hit, and between each curve and the reported point
+static void checkHit(const std::vector<Vec3d> &a, const std::vector<Vec3d> &b, const CurveIntersectionT<double> &hit) {
+    Vec3d pointA = BezierPointByCasteljau(a, hit.uA);
+    Vec3d pointB = BezierPointByCasteljau(b, hit.uB);
+
+    CHECK_NEAR((pointA - pointB).length(), 0, INTERSECTION_TEST_TOLERANCE);
+    CHECK_NEAR((pointA - hit.point).length(), 0, INTERSECTION_TEST_TOLERANCE);
+}
+
+// Two cubic diagonals of the square [0, 2]^2, their control points evenly spaced
+void TestIntersectionCrossingLines() {
+    const std::vector<Vec3d> a = {Vec3d(0, 0, 0), Vec3d(2.0 / 3, 2.0 / 3, 0), Vec3d(4.0 / 3, 4.0 / 3, 0), Vec3d(2, 2, 0)};
+    const std::vector<Vec3d> b = {Vec3d(0, 2, 0), Vec3d(2.0 / 3, 4.0 / 3, 0), Vec3d(4.0 / 3, 2.0 / 3, 0), Vec3d(2, 0, 0)};
+
+    std::vector<CurveIntersectionT<double> > hits = BezierIntersections(a, b, INTERSECTION_TEST_TOLERANCE);
+
+    CHECK(hits.size() == 1);
+
+    if (hits.size() == 1) {
+        checkHit(a, b, hits[0]);
+        CHECK_NEAR(hits[0].uA, 0.5, 1e-8);
+        CHECK_NEAR(hits[0].uB, 0.5, 1e-8);
+        CHECK(hits[0].curveA == 0 && hits[0].curveB == 1);
+    }
+}
+
+// The arch y = 4 u (1 - u), x = 2 u, crossed by y = 1/2 at u = (1 -+ sqrt(1/2)) / 2
+void TestIntersectionArchAndLine() {
+    const std::vector<Vec3d> arch = {Vec3d(0, 0, 0), Vec3d(1, 2, 0), Vec3d(2, 0, 0)};
+    const std::vector<Vec3d> line = {Vec3d(-1, 0.5, 0), Vec3d(3, 0.5, 0)};
+
+    std::vector<CurveIntersectionT<double> > hits = BezierIntersections(arch, line, INTERSECTION_TEST_TOLERANCE);
+
+    CHECK(hits.size() == 2);
+
+    if (hits.size() == 2) {
+        // Sorted along the first curve
+        CHECK_NEAR(hits[0].uA, (1 - std::sqrt(0.5)) / 2, 1e-8);
+        CHECK_NEAR(hits[1].uA, (1 + std::sqrt(0.5)) / 2, 1e-8);
+
+        for (const CurveIntersectionT<double> &hit : hits) {
+            checkHit(arch, line, hit);
+            CHECK_NEAR(hit.point[0], 4 * hit.uB - 1, 1e-8);
+        }
+    }
+}
+
+// y = 1 touches the same arch at its top (1, 1): one contact, not a cluster of hits
+void TestIntersectionTangentTouch() {
+    const std::vector<Vec3d> arch = {Vec3d(0, 0, 0), Vec3d(1, 2, 0), Vec3d(2, 0, 0)};
+    const std::vector<Vec3d> line = {Vec3d(-1, 1, 0), Vec3d(3, 1, 0)};
+
+    std::vector<CurveIntersectionT<double> > hits = BezierIntersections(arch, line, INTERSECTION_TEST_TOLERANCE);
+
+    CHECK(hits.size() == 1);
+
+    if (hits.size() == 1) {
+        checkHit(arch, line, hits[0]);
+
+        // The curves stay within tolerance while |x - 1| < sqrt(tolerance)
+        CHECK_NEAR(hits[0].point[0], 1, 2 * std::sqrt(INTERSECTION_TEST_TOLERANCE));
+        CHECK_NEAR(hits[0].point[1], 1, INTERSECTION_TEST_TOLERANCE);
+    }
+
+    // Moved up by more than tolerance, the line misses
+    const std::vector<Vec3d> above = {Vec3d(-1, 1 + 1e-6, 0), Vec3d(3, 1 + 1e-6, 0)};
+
+    CHECK(BezierIntersections(arch, above, INTERSECTION_TEST_TOLERANCE).empty());
+}
+
+// A cubic symmetric under x -> 1 - x, u -> 1 - u, whose legs cross: it loops once, on x = 1/2
+void TestIntersectionSelfLoop() {
+    const std::vector<Vec3d> loop = {Vec3d(0, 0, 0), Vec3d(2, 1, 0), Vec3d(-1, 1, 0), Vec3d(1, 0, 0)};
+
+    std::vector<CurveIntersectionT<double> > hits = BezierSelfIntersections(loop, INTERSECTION_TEST_TOLERANCE);
+
+    CHECK(hits.size() == 1);
+
+    if (hits.size() == 1) {
+        checkHit(loop, loop, hits[0]);
+        CHECK(hits[0].curveA == 0 && hits[0].curveB == 0);
+        CHECK(hits[0].uA < hits[0].uB);
+        CHECK_NEAR(hits[0].uA + hits[0].uB, 1, 1e-8);
+        CHECK_NEAR(hits[0].point[0], 0.5, 1e-8);
+    }
+
+    // Without crossing legs the same kind of curve does not loop
+    const std::vector<Vec3d> arch = {Vec3d(0, 0, 0), Vec3d(0.25, 1, 0), Vec3d(0.75, 1, 0), Vec3d(1, 0, 0)};
+
+    CHECK(BezierSelfIntersections(arch, INTERSECTION_TEST_TOLERANCE).empty());
+}
+
+// Random boxes, some sharing a face exactly and some empty, against the test of every pair
+void TestIntersectionBoxPairsMatchBruteForce() {
+    std::mt19937 generator(16);
+    std::uniform_real_distribution<float> coordinate(0, 10);
+    std::uniform_real_distribution<float> size(0, 1.5f);
+    std::uniform_int_distribution<int> integer(0, 8);
+    std::vector<AABB> boxes;
+
+    for (int n = 0; n < 400; n++) {
+        Vec3 min(coordinate(generator), coordinate(generator), coordinate(generator));
+
+        boxes.push_back(AABB(min, min + Vec3(size(generator), size(generator), size(generator))));
+    }
+
+    // Unit cubes on an integer grid: neighbours touch on a face, an edge or a corner
+    for (int n = 0; n < 200; n++) {
+        Vec3 min(integer(generator), integer(generator), integer(generator));
+
+        boxes.push_back(AABB(min, min + Vec3(1, 1, 1)));
+    }
+
+    for (int n = 0; n < 20; n++) {
+        boxes.insert(boxes.begin() + 31 * n, AABB());
+    }
+
+    std::vector<std::pair<size_t, size_t> > expected;
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+        for (size_t j = i + 1; j < boxes.size(); j++) {
+            if (!boxes[i].empty() && !boxes[j].empty() && boxes[i].overlaps(boxes[j])) {
+                expected.push_back(std::make_pair(i, j));
+            }
+        }
+    }
+
+    CHECK(expected.size() > boxes.size());
+    CHECK(OverlappingBoxPairs(boxes) == expected);
+}
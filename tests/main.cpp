@@ -0,0 +1,87 @@
+//
+// Runs the test cases named on the command line, or all of them.
+// ctest registers each case on its own, see CMakeLists.txt.
+//
+
+#include <cstring>
+#include "testing.h"
+
+int TestFailures = 0;
+
+struct TestCase {
+    const char *name;
+    void (*run)();
+};
+
+static const TestCase TEST_CASES[] = {
+        {"casteljau_allocations", TestCasteljauAllocations},
+        {"batch_malformed_hermite", TestBatchMalformedHermite},
+        {"batch_nonpositive_nbu", TestBatchNonPositiveNbU},
+        {"adaptive_vertex_count", TestAdaptiveVertexCount},
+        {"adaptive_endpoints", TestAdaptiveEndpoints},
+        {"monomial_schemes", TestMonomialSchemes},
+        {"monomial_unconverted", TestMonomialUnconverted},
+        {"rational_circle", TestRationalCircle},
+        {"svd_matches_gsl", TestSvdMatchesGsl},
+        {"mat3_pseudo_inverse", TestMat3PseudoInverse},
+        {"basis_cache_counters", TestBasisCacheCounters},
+        {"basis_cache_eviction", TestBasisCacheEviction},
+        {"basis_cache_over_budget", TestBasisCacheOverBudget},
+        {"simd_matches_scalar", TestSimdMatchesScalar},
+        {"bezier_dispatch", TestBezierDispatchMatchesCasteljau},
+        {"batch_parallel_matches_serial", TestBatchParallelMatchesSerial},
+        {"arc_length_straight_line", TestArcLengthStraightLine},
+        {"arc_length_round_trip", TestArcLengthRoundTrip},
+        {"intersection_crossing_lines", TestIntersectionCrossingLines},
+        {"intersection_arch_and_line", TestIntersectionArchAndLine},
+        {"intersection_tangent_touch", TestIntersectionTangentTouch},
+        {"intersection_self_loop", TestIntersectionSelfLoop},
+        {"intersection_box_pairs", TestIntersectionBoxPairsMatchBruteForce},
+        {"closest_point_dense_search", TestClosestPointMatchesDenseSearch},
+        {"bounds_dense_samples", TestBoundsMatchDenseSamples},
+        {"bounds_cache_invalidation", TestBoundsCacheInvalidation},
+        {"bspline_insert_knot", TestBSplineInsertKnot},
+        {"bspline_bezier_segments", TestBSplineBezierSegments},
+        {"bspline_curve", TestBSplineCurve},
+        {"vec3_array_kernels", TestVec3ArrayKernelsMatchVec3},
+        {"vec3_array_move", TestVec3ArrayMove},
+        {"vec3_array_engine_outputs", TestVec3ArrayEngineOutputs},
+        {"transform_products", TestTransformProducts},
+        {"transform_rotations_scales", TestTransformRotationsAndScales},
+        {"transform_compose_chain", TestTransformComposeChain},
+        {"transform_soa_matches_aos", TestTransformSoAMatchesAoS},
+};
+
+int main(int argc, char **argv) {
+    int failedCases = 0;
+    int ranCases = 0;
+
+    for (const TestCase &testCase : TEST_CASES) {
+        bool selected = argc < 2;
+
+        for (int i = 1; i < argc; i++) {
+            selected = selected || std::strcmp(argv[i], testCase.name) == 0;
+        }
+
+        if (!selected) {
+            continue;
+        }
+
+        TestFailures = 0;
+        testCase.run();
+        ranCases++;
+
+        std::cout << (TestFailures == 0 ? "[ OK ] " : "[FAIL] ") << testCase.name << std::endl;
+
+        if (TestFailures != 0) {
+            failedCases++;
+        }
+    }
+
+    if (ranCases == 0) {
+        std::cerr << "no test case matches" << std::endl;
+        return 1;
+    }
+
+    return failedCases == 0 ? 0 : 1;
+}
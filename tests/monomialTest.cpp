@@ -0,0 +1,50 @@
+//
+// Monomial basis: agreement with de Casteljau, and its fallback past MONOMIAL_MAX_POINTS.
+//
+
+#include <cmath>
+#include "testing.h"
+#include "../Berstein/monomial.h"
+#include "../Casteljau/casteljau.h"
+
+static std::vector<Vec3> polygon(size_t nbPoints) {
+    std::vector<Vec3> points(nbPoints);
+
+    for (size_t i = 0; i < nbPoints; i++) {
+        float t = (float) i / (float) nbPoints;
+        points[i] = Vec3(t, std::sin(6 * t), std::cos(3 * t));
+    }
+
+    return points;
+}
+
+void TestMonomialSchemes() {
+    std::vector<Vec3> controlPoints = polygon(6);
+    MonomialCurve curve(controlPoints);
+
+    CHECK(curve.usesMonomialBasis());
+
+    for (int i = 0; i <= 16; i++) {
+        float u = (float) i / 16.0f;
+        Vec3 expected = BezierPointByCasteljau(controlPoints, u);
+
+        CHECK_NEAR((curve.pointByHorner(u) - expected).length(), 0, 1e-5);
+        CHECK_NEAR((curve.pointByEstrin(u) - expected).length(), 0, 1e-5);
+    }
+}
+
+void TestMonomialUnconverted() {
+    std::vector<Vec3> controlPoints = polygon(MONOMIAL_MAX_POINTS + 1);
+    MonomialCurve curve(controlPoints);
+
+    CHECK(!curve.usesMonomialBasis());
+
+    // Never converted: both schemes are de Casteljau, not zero
+    for (int i = 0; i <= 16; i++) {
+        float u = (float) i / 16.0f;
+        Vec3 expected = BezierPointByCasteljau(controlPoints, u);
+
+        CHECK((curve.pointByHorner(u) - expected).squareLength() == 0);
+        CHECK((curve.pointByEstrin(u) - expected).squareLength() == 0);
+    }
+}
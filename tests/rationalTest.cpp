@@ -0,0 +1,57 @@
+//
+// Rational Bezier curves: exact circles, against the vertices tp.cpp's drawCircle emits.
+//
+
+#include <cmath>
+#include "testing.h"
+#include "../Rational/rationalBezier.h"
+
+// drawCircle's polygon: 10 vertices at angle 2 pi i / 10 around center, in the plane z = center z
+static const int CIRCLE_TEST_VERTICES = 10;
+
+// A few float roundings of coordinates below 2
+static const float CIRCLE_TEST_TOLERANCE = 1e-6f;
+
+static Vec3 drawCircleVertex(const Vec3 &center, float radius, int i) {
+    float angle = 2 * M_PI * (float) i / (float) CIRCLE_TEST_VERTICES;
+
+    return Vec3(center[0] + radius * std::cos(angle), center[1] + radius * std::sin(angle), center[2]);
+}
+
+void TestRationalCircle() {
+    const Vec3 center(0.3f, -0.2f, 0.1f);
+
+    // drawControlPoints' radius, and a unit circle
+    for (float radius : {0.025f, 1.0f}) {
+        std::vector<Vec3> controlPoints;
+        std::vector<float> weights;
+
+        // One arc per edge of drawCircle's polygon, its ends on the polygon's vertices
+        for (int i = 0; i < CIRCLE_TEST_VERTICES; i++) {
+            float startAngle = 2 * M_PI * (float) i / (float) CIRCLE_TEST_VERTICES;
+            float endAngle = 2 * M_PI * (float) (i + 1) / (float) CIRCLE_TEST_VERTICES;
+
+            RationalQuadraticArc(center, radius, startAngle, endAngle, controlPoints, weights);
+
+            Vec3 start = RationalBezierPointByCasteljau(controlPoints, weights, 0.0f);
+            Vec3 end = RationalBezierPointByCasteljau(controlPoints, weights, 1.0f);
+
+            CHECK_NEAR((start - drawCircleVertex(center, radius, i)).length(), 0, CIRCLE_TEST_TOLERANCE);
+            CHECK_NEAR((end - drawCircleVertex(center, radius, i + 1)).length(), 0, CIRCLE_TEST_TOLERANCE);
+
+            // Halfway in u is halfway in angle on a symmetric arc
+            Vec3 middle = RationalBezierPointByCasteljau(controlPoints, weights, 0.5f);
+            float middleAngle = (startAngle + endAngle) / 2;
+            Vec3 expected(center[0] + radius * std::cos(middleAngle), center[1] + radius * std::sin(middleAngle),
+                          center[2]);
+
+            CHECK_NEAR((middle - expected).length(), 0, CIRCLE_TEST_TOLERANCE);
+
+            // Every sample on the circle, not only near it like the polygon
+            for (const Vec3 &point : RationalBezierCurveByCasteljau(controlPoints, weights, 64)) {
+                CHECK_NEAR((point - center).length(), radius, CIRCLE_TEST_TOLERANCE);
+                CHECK_NEAR(point[2], center[2], CIRCLE_TEST_TOLERANCE);
+            }
+        }
+    }
+}
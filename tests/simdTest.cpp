@@ -0,0 +1,73 @@
+//
+// SIMD kernels: every instruction set against the scalar evaluators, bitwise (Simd/simd.h's 0 ULP).
+//
+
+#include <cmath>
+#include <cstring>
+#include "testing.h"
+#include "../Simd/simd.h"
+#include "../Casteljau/casteljau.h"
+#include "../Hermite/hermite.h"
+#include "../Rational/rationalBezier.h"
+
+static bool sameBits(const Vec3Array &lanes, const std::vector<Vec3> &points) {
+    if (lanes.size() != points.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < points.size(); i++) {
+        Vec3 lane = lanes.get(i);
+
+        if (std::memcmp(&lane, &points[i], sizeof(Vec3)) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TestSimdMatchesScalar() {
+    SimdIsa detected = ActiveSimdIsa();
+    const SimdIsa isas[] = {SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512};
+
+    for (SimdIsa isa : isas) {
+        if (!SetSimdIsa(isa)) {
+            continue;
+        }
+
+        // Around the stack polygon size of the scalar path, and sample counts leaving partial lanes
+        for (size_t nbPoints : {1, 2, 4, 7, 16, 17, 25}) {
+            std::vector<Vec3> controlPoints(nbPoints);
+            std::vector<float> weights(nbPoints);
+
+            for (size_t i = 0; i < nbPoints; i++) {
+                controlPoints[i] = Vec3(std::sin(1.3f * i), 0.1f * i - 1, std::cos(0.7f * i));
+                weights[i] = 0.5f + 0.25f * (float) (i % 4);
+            }
+
+            for (long nbU : {1L, 13L, 100L}) {
+                Vec3Array lanes;
+
+                BezierCurveSoA(controlPoints, nbU, lanes);
+                CHECK(sameBits(lanes, BezierCurveByCasteljau(controlPoints, nbU)));
+
+                RationalBezierCurveSoA(controlPoints, weights, nbU, lanes);
+                CHECK(sameBits(lanes, RationalBezierCurveByCasteljau(controlPoints, weights, nbU)));
+            }
+        }
+
+        Vec3 p0(0, 0, 0);
+        Vec3 p1(1, 0.5f, 0.25f);
+        Vec3 v0(1, 2, 0);
+        Vec3 v1(1, -2, 0.5f);
+
+        for (long nbU : {1L, 13L, 100L}) {
+            Vec3Array lanes;
+
+            HermiteCubicCurveSoA(p0, p1, v0, v1, nbU, lanes);
+            CHECK(sameBits(lanes, HermiteCubicCurve(p0, p1, v0, v1, nbU)));
+        }
+    }
+
+    SetSimdIsa(detected);
+}
@@ -0,0 +1,151 @@
+//
+// Mat3::SVD and Mat3SVDBatch against gsl_linalg_SV_decomp, and the pseudo-inverse of Mat3::inverse.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <gsl/gsl_linalg.h>
+#include "testing.h"
+#include "../Svd/svd.h"
+
+// Relative to the largest singular value, a few float roundings
+static const double SVD_TEST_TOLERANCE = 1e-5;
+
+// Singular values of m by GSL's Golub-Reinsch, in double, decreasing.
+static Vec3d gslSingularValues(const Mat3 &m) {
+    gsl_matrix *a = gsl_matrix_alloc(3, 3);
+    gsl_matrix *v = gsl_matrix_alloc(3, 3);
+    gsl_vector *s = gsl_vector_alloc(3);
+    gsl_vector *work = gsl_vector_alloc(3);
+
+    for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            gsl_matrix_set(a, i, j, m(i, j));
+        }
+    }
+
+    gsl_linalg_SV_decomp(a, v, s, work);
+    Vec3d sigma(gsl_vector_get(s, 0), gsl_vector_get(s, 1), gsl_vector_get(s, 2));
+
+    gsl_vector_free(work);
+    gsl_vector_free(s);
+    gsl_matrix_free(v);
+    gsl_matrix_free(a);
+
+    return sigma;
+}
+
+static double largestDifference(const Mat3 &a, const Mat3 &b) {
+    double difference = 0;
+
+    for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            difference = std::max(difference, (double) std::fabs(a(i, j) - b(i, j)));
+        }
+    }
+
+    return difference;
+}
+
+// Random full rank matrices, then rank 2, rank 1 and zero ones built from integer rows, so that
+// their determinant is exactly 0 in float.
+static std::vector<Mat3> svdTestMatrices() {
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> coefficient(-1, 1);
+    std::uniform_int_distribution<int> integer(-4, 4);
+    std::vector<Mat3> matrices;
+
+    for (int n = 0; n < 200; n++) {
+        Mat3 m;
+
+        for (unsigned int c = 0; c < 9; c++) {
+            m(c / 3, c % 3) = coefficient(generator);
+        }
+
+        matrices.push_back(m);
+    }
+
+    for (int n = 0; n < 100; n++) {
+        Vec3 r1(integer(generator), integer(generator), integer(generator));
+        Vec3 r2(integer(generator), integer(generator), integer(generator));
+        int a = integer(generator);
+        int b = integer(generator);
+
+        matrices.push_back(Mat3::getFromRows(r1, r2, (float) a * r1 + (float) b * r2));
+        matrices.push_back(Mat3::getFromRows(r1, (float) a * r1, (float) b * r1));
+    }
+
+    matrices.push_back(Mat3::Zero());
+
+    return matrices;
+}
+
+void TestSvdMatchesGsl() {
+    std::vector<Mat3> matrices = svdTestMatrices();
+    std::vector<Mat3> batchU(matrices.size());
+    std::vector<Vec3> batchSigma(matrices.size());
+    std::vector<Mat3> batchVt(matrices.size());
+
+    Mat3SVDBatch(matrices.data(), matrices.size(), batchU.data(), batchSigma.data(), batchVt.data());
+
+    // The same decompositions spread over a pool
+    std::vector<Mat3> pooledU(matrices.size());
+    std::vector<Vec3> pooledSigma(matrices.size());
+    std::vector<Mat3> pooledVt(matrices.size());
+    ThreadPool pool(4);
+
+    Mat3SVDBatch(matrices.data(), matrices.size(), pooledU.data(), pooledSigma.data(), pooledVt.data(), pool);
+
+    CHECK(std::memcmp(pooledU.data(), batchU.data(), matrices.size() * sizeof(Mat3)) == 0);
+    CHECK(std::memcmp(pooledSigma.data(), batchSigma.data(), matrices.size() * sizeof(Vec3)) == 0);
+    CHECK(std::memcmp(pooledVt.data(), batchVt.data(), matrices.size() * sizeof(Mat3)) == 0);
+
+    for (size_t n = 0; n < matrices.size(); n++) {
+        const Mat3 &m = matrices[n];
+        Vec3d expected = gslSingularValues(m);
+        double tolerance = SVD_TEST_TOLERANCE * std::max(1.0, expected[0]);
+
+        Mat3 U;
+        Mat3 Vt;
+        float sx;
+        float sy;
+        float sz;
+        m.SVD(U, sx, sy, sz, Vt);
+
+        CHECK_NEAR(sx, expected[0], tolerance);
+        CHECK_NEAR(sy, expected[1], tolerance);
+        CHECK_NEAR(sz, expected[2], tolerance);
+
+        for (unsigned int k = 0; k < 3; k++) {
+            CHECK_NEAR(batchSigma[n][k], expected[k], 10 * tolerance);
+        }
+
+        const Vec3 &sigma = batchSigma[n];
+
+        CHECK(largestDifference(batchU[n] * Mat3::diag(sigma[0], sigma[1], sigma[2]) * batchVt[n], m) <= tolerance);
+        CHECK(largestDifference(batchU[n] * batchU[n].getTranspose(), Mat3::Identity()) <= SVD_TEST_TOLERANCE);
+        CHECK(largestDifference(batchVt[n] * batchVt[n].getTranspose(), Mat3::Identity()) <= SVD_TEST_TOLERANCE);
+
+        CHECK(largestDifference(U * Mat3::diag(sx, sy, sz) * Vt, m) <= tolerance);
+        CHECK(largestDifference(U * U.getTranspose(), Mat3::Identity()) <= SVD_TEST_TOLERANCE);
+        CHECK(largestDifference(Vt * Vt.getTranspose(), Mat3::Identity()) <= SVD_TEST_TOLERANCE);
+    }
+}
+
+// Mat3::inverse used to divide by the zero singular values of a singular matrix and drop the others.
+void TestMat3PseudoInverse() {
+    for (const Mat3 &m : svdTestMatrices()) {
+        Mat3 inverse = Mat3::inverse(m);
+        double tolerance = SVD_TEST_TOLERANCE * std::max(1.0, gslSingularValues(m)[0]);
+
+        if (m.determinant() != 0) {
+            CHECK(largestDifference(m * inverse, Mat3::Identity()) <= 1e-3);
+            continue;
+        }
+
+        // Moore-Penrose conditions, M M+ M = M and M+ M M+ = M+
+        CHECK(largestDifference(m * inverse * m, m) <= tolerance);
+        CHECK(largestDifference(inverse * m * inverse, inverse) <= tolerance);
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Minimal checks for the curveTests executable: a failed check is reported and counted,
+// the test case goes on so that one run shows every failure.
+//
+
+#ifndef MODELISATION_TP1_TESTING_H
+#define MODELISATION_TP1_TESTING_H
+
+#include <cmath>
+#include <iostream>
+
+// Failed checks of the running test case, reset by main before each case.
+extern int TestFailures;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+            TestFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) \
+    do { \
+        double checkA = (double) (a); \
+        double checkB = (double) (b); \
+        if (!(std::fabs(checkA - checkB) <= (double) (tolerance))) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK_NEAR(" #a ", " #b ") failed: " \
+                      << checkA << " vs " << checkB << ", tolerance " << (double) (tolerance) << std::endl; \
+            TestFailures++; \
+        } \
+    } while (0)
+
+// Test cases, defined next to the module they cover and listed in main.cpp.
+void TestCasteljauAllocations();
+void TestBatchMalformedHermite();
+void TestBatchNonPositiveNbU();
+void TestAdaptiveVertexCount();
+void TestAdaptiveEndpoints();
+void TestMonomialSchemes();
+void TestMonomialUnconverted();
+void TestRationalCircle();
+void TestSvdMatchesGsl();
+void TestMat3PseudoInverse();
+void TestBasisCacheCounters();
+void TestBasisCacheEviction();
+void TestBasisCacheOverBudget();
+void TestSimdMatchesScalar();
+void TestBezierDispatchMatchesCasteljau();
+void TestBatchParallelMatchesSerial();
+void TestArcLengthStraightLine();
+void TestArcLengthRoundTrip();
+void TestIntersectionCrossingLines();
+void TestIntersectionArchAndLine();
+void TestIntersectionTangentTouch();
+void TestIntersectionSelfLoop();
+void TestIntersectionBoxPairsMatchBruteForce();
+void TestClosestPointMatchesDenseSearch();
+void TestBoundsMatchDenseSamples();
+void TestBoundsCacheInvalidation();
+void TestBSplineInsertKnot();
+void TestBSplineBezierSegments();
+void TestBSplineCurve();
+void TestVec3ArrayKernelsMatchVec3();
+void TestVec3ArrayMove();
+void TestVec3ArrayEngineOutputs();
+void TestTransformProducts();
+void TestTransformRotationsAndScales();
+void TestTransformComposeChain();
+void TestTransformSoAMatchesAoS();
+
+#endif //MODELISATION_TP1_TESTING_H
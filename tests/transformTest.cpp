@@ -0,0 +1,144 @@
+//
+// Transforms: known rotations and scales, composition order, and the SoA path against the AoS one.
+//
+
+#include <cmath>
+#include <cstring>
+#include "testing.h"
+#include "../Transform/transform.h"
+#include "../Simd/simd.h"
+
+static bool sameBits(const Vec3 &a, const Vec3 &b) {
+    return std::memcmp(&a, &b, sizeof(Vec3)) == 0;
+}
+
+static bool sameBits(const Mat3 &a, const Mat3 &b) {
+    return std::memcmp(&a, &b, sizeof(Mat3)) == 0;
+}
+
+// Rotation by angle around z, x turning towards y
+static Mat3 rotationZ(float angle) {
+    return Mat3(std::cos(angle), -std::sin(angle), 0,
+                std::sin(angle), std::cos(angle), 0,
+                0, 0, 1);
+}
+
+// Small integer matrices and points: every product below is exact in float
+void TestTransformProducts() {
+    const Mat3 a(1, 2, 3, 4, 5, 6, 7, 8, 10);
+    const Mat3 b(2, 0, -1, 1, 3, 0, 0, -2, 1);
+    const Vec3 p(1, -2, 3);
+
+    CHECK(sameBits(a * p, Vec3(1 - 4 + 9, 4 - 10 + 18, 7 - 16 + 30)));
+
+    // Row i of a times column j of b
+    CHECK(sameBits(a * b, Mat3(4, 0, 2, 13, 3, 2, 22, 4, 3)));
+    CHECK(sameBits(b * a, Mat3(-5, -4, -4, 13, 17, 21, -1, -2, -2)));
+
+    // m.m2 applies m2 first
+    CHECK(sameBits((a * b) * p, a * (b * p)));
+
+    CHECK(sameBits(Mat3::Identity() * p, p));
+    CHECK(sameBits(a * Mat3::Identity(), a));
+    CHECK(sameBits(Mat3::diag(2.0f, 3.0f, 4.0f) * p, Vec3(2, -6, 12)));
+}
+
+void TestTransformRotationsAndScales() {
+    const float quarter = (float) M_PI / 2;
+
+    // A quarter turn around z sends x to y and y to -x, keeps z
+    CHECK_NEAR((rotationZ(quarter) * Vec3(1, 0, 0) - Vec3(0, 1, 0)).length(), 0, 1e-7);
+    CHECK_NEAR((rotationZ(quarter) * Vec3(0, 1, 0) - Vec3(-1, 0, 0)).length(), 0, 1e-7);
+    CHECK(sameBits(rotationZ(quarter) * Vec3(0, 0, 2), Vec3(0, 0, 2)));
+
+    // Rotations keep lengths, eight eighth turns come back to the start
+    Vec3 p(0.3f, -1.2f, 0.7f);
+    Vec3 q = p;
+
+    for (int i = 0; i < 8; i++) {
+        q = rotationZ(quarter / 2) * q;
+        CHECK_NEAR(q.length(), p.length(), 1e-6);
+    }
+
+    CHECK_NEAR((q - p).length(), 0, 1e-6);
+
+    // Scale then move: p -> (2 px, 3 py, 4 pz) + (1, 1, 1)
+    AffineTransform scaleThenMove(Mat3::diag(2.0f, 3.0f, 4.0f), Vec3(1, 1, 1));
+
+    CHECK(sameBits(scaleThenMove(Vec3(1, -2, 0.5f)), Vec3(3, -5, 3)));
+}
+
+// ComposeChain applies transforms[0] last: chain(p) = t0(t1(t2(p)))
+void TestTransformComposeChain() {
+    const Mat3 rotation(0, -1, 0, 1, 0, 0, 0, 0, 1);
+    const Mat3 scale = Mat3::diag(2.0f, 1.0f, 1.0f);
+    const Mat3 shear(1, 1, 0, 0, 1, 0, 0, 0, 1);
+    const Vec3 p(1, 2, 3);
+
+    Mat3 chain = ComposeChain(std::vector<Mat3>{rotation, scale, shear});
+
+    CHECK(sameBits(chain * p, rotation * (scale * (shear * p))));
+    CHECK(sameBits(chain * p, Vec3(-2, 6, 3)));
+    // The other order gives another point, so the test does see the order
+    CHECK(!sameBits(ComposeChain(std::vector<Mat3>{shear, scale, rotation}) * p, chain * p));
+
+    CHECK(sameBits(ComposeChain(std::vector<Mat3>()), Mat3::Identity()));
+
+    AffineTransform move(Mat3::Identity(), Vec3(1, 0, 0));
+    AffineTransform turn(rotation, Vec3(0, 0, 1));
+    AffineTransform grow(scale, Vec3(0, -1, 0));
+    AffineTransform affineChain = ComposeChain(std::vector<AffineTransform>{move, turn, grow});
+
+    CHECK(sameBits(affineChain(p), move(turn(grow(p)))));
+    CHECK(sameBits(affineChain(p), Vec3(0, 2, 4)));
+    CHECK(sameBits(Compose(move, turn)(p), move(turn(p))));
+}
+
+// The SIMD kernel over lanes against Mat3 * Vec3 + translation point by point, on every instruction
+// set, below and past the size where the pool takes over
+void TestTransformSoAMatchesAoS() {
+    SimdIsa detected = ActiveSimdIsa();
+    const SimdIsa isas[] = {SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512};
+    const AffineTransform transform(rotationZ(0.3f) * Mat3::diag(1.5f, 0.5f, 2.0f), Vec3(0.1f, -2, 3));
+    ThreadPool pool(4);
+
+    for (SimdIsa isa : isas) {
+        if (!SetSimdIsa(isa)) {
+            continue;
+        }
+
+        for (size_t size : {(size_t) 0, (size_t) 1, (size_t) 7, (size_t) 33, TRANSFORM_PARALLEL_THRESHOLD + 5}) {
+            std::vector<Vec3> points(size);
+
+            for (size_t i = 0; i < size; i++) {
+                points[i] = Vec3(std::sin(0.1f * i), std::cos(0.37f * i) * 4, 0.001f * i);
+            }
+
+            std::vector<Vec3> aos(size);
+            Vec3Array lanes(points);
+            Vec3Array soa(size);
+
+            TransformPoints(transform, points.data(), size, aos.data(), pool);
+            TransformPoints(transform, lanes.view(), soa.view(), pool);
+
+            bool same = true;
+
+            for (size_t i = 0; i < size; i++) {
+                same = same && sameBits(soa.get(i), aos[i]) && sameBits(aos[i], transform(points[i]));
+            }
+
+            CHECK(same);
+
+            // In place
+            TransformPoints(transform, lanes.view(), lanes.view(), pool);
+
+            for (size_t i = 0; i < size; i++) {
+                same = same && sameBits(lanes.get(i), aos[i]);
+            }
+
+            CHECK(same);
+        }
+    }
+
+    SetSimdIsa(detected);
+}
@@ -0,0 +1,205 @@
+//
+// Vec3Array: whole array kernels bitwise against the Vec3 operators on every instruction set,
+// moves, and the curve engines writing into lanes.
+//
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include "testing.h"
+#include "../Simd/simd.h"
+#include "../Simd/vec3Array.h"
+#include "../Casteljau/casteljau.h"
+#include "../Berstein/berstein.h"
+#include "../Hermite/hermite.h"
+#include "../BSpline/bspline.h"
+#include "../Batch/batch.h"
+
+static bool sameBits(const Vec3 &a, const Vec3 &b) {
+    return std::memcmp(&a, &b, sizeof(Vec3)) == 0;
+}
+
+static bool sameBits(const Vec3Array &lanes, const std::vector<Vec3> &points) {
+    if (lanes.size() != points.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < points.size(); i++) {
+        if (!sameBits(lanes.get(i), points[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Non zero points of mixed magnitudes, so that normalize divides by a proper length
+static Vec3Array testArray(size_t size, float phase) {
+    Vec3Array array(size);
+
+    for (size_t i = 0; i < size; i++) {
+        float t = phase + 0.37f * (float) i;
+
+        array.set(i, Vec3(std::sin(t) * 3, std::cos(1.7f * t) + 1.5f, std::sin(0.3f * t) / 7));
+    }
+
+    return array;
+}
+
+void TestVec3ArrayKernelsMatchVec3() {
+    SimdIsa detected = ActiveSimdIsa();
+    const SimdIsa isas[] = {SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512};
+    const float s = 0.7f;
+    const float t = 0.3f;
+
+    for (SimdIsa isa : isas) {
+        if (!SetSimdIsa(isa)) {
+            continue;
+        }
+
+        // Empty, shorter than a lane, whole lanes and partial last lanes
+        for (size_t size : {0, 1, 7, 16, 33, 100}) {
+            Vec3Array a = testArray(size, 0.1f);
+            Vec3Array b = testArray(size, 2.9f);
+            Vec3Array out(size);
+            std::vector<float> dots(size);
+
+            Vec3ArrayAdd(a.view(), b.view(), out.view());
+            for (size_t i = 0; i < size; i++) {
+                CHECK(sameBits(out.get(i), a.get(i) + b.get(i)));
+            }
+
+            Vec3ArrayScale(a.view(), s, out.view());
+            for (size_t i = 0; i < size; i++) {
+                CHECK(sameBits(out.get(i), s * a.get(i)));
+            }
+
+            Vec3ArrayLerp(a.view(), b.view(), t, out.view());
+            for (size_t i = 0; i < size; i++) {
+                CHECK(sameBits(out.get(i), Vec3::lerp(a.get(i), b.get(i), t)));
+            }
+
+            Vec3ArrayDot(a.view(), b.view(), dots.data());
+            for (size_t i = 0; i < size; i++) {
+                float dot = Vec3::dot(a.get(i), b.get(i));
+
+                CHECK(std::memcmp(&dots[i], &dot, sizeof(float)) == 0);
+            }
+
+            Vec3ArrayCross(a.view(), b.view(), out.view());
+            for (size_t i = 0; i < size; i++) {
+                CHECK(sameBits(out.get(i), Vec3::cross(a.get(i), b.get(i))));
+            }
+
+            Vec3ArrayNormalize(a.view(), out.view());
+            for (size_t i = 0; i < size; i++) {
+                Vec3 normalized = a.get(i);
+                normalized.normalize();
+
+                CHECK(sameBits(out.get(i), normalized));
+            }
+
+            // In place, out aliasing the first input
+            Vec3Array sum = a;
+            Vec3ArrayAdd(sum.view(), b.view(), sum.view());
+            for (size_t i = 0; i < size; i++) {
+                CHECK(sameBits(sum.get(i), a.get(i) + b.get(i)));
+            }
+        }
+    }
+
+    SetSimdIsa(detected);
+}
+
+void TestVec3ArrayMove() {
+    static_assert(std::is_nothrow_move_constructible<Vec3Array>::value, "Vec3Array moves must not throw");
+    static_assert(std::is_nothrow_move_assignable<Vec3Array>::value, "Vec3Array moves must not throw");
+
+    Vec3Array source = testArray(33, 0.5f);
+    std::vector<Vec3> points = source.toVector();
+    const float *lanes = source.x();
+
+    // The lanes change hands, nothing is copied
+    Vec3Array moved(std::move(source));
+
+    CHECK(moved.x() == lanes);
+    CHECK(sameBits(moved, points));
+    CHECK(source.size() == 0);
+
+    Vec3Array assigned = testArray(5, 1.0f);
+    assigned = std::move(moved);
+
+    CHECK(assigned.x() == lanes);
+    CHECK(sameBits(assigned, points));
+    CHECK(moved.size() == 0);
+
+    // A moved from array is empty and usable again
+    moved.resize(3);
+    CHECK(moved.size() == 3);
+    CHECK(sameBits(moved.get(2), Vec3(0, 0, 0)));
+}
+
+// Every engine's lanes overload writes the same points as its vector overload
+void TestVec3ArrayEngineOutputs() {
+    std::vector<Vec3> controlPoints;
+
+    for (int i = 0; i < 6; i++) {
+        controlPoints.push_back(Vec3(std::sin(1.1f * i), 0.2f * i, std::cos(0.9f * i)));
+    }
+
+    Vec3Array out(4);
+
+    for (long nbU : {0L, 1L, 13L, 100L}) {
+        BezierCurveByCasteljau(controlPoints, nbU, out);
+        CHECK(sameBits(out, BezierCurveByCasteljau(controlPoints, nbU)));
+
+        BezierCurveByBernstein(controlPoints, nbU, out);
+        CHECK(sameBits(out, BezierCurveByBernstein(controlPoints, nbU)));
+
+        HermiteCubicCurve(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3], nbU, out);
+        CHECK(sameBits(out, HermiteCubicCurve(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3],
+                                              nbU)));
+
+        BSpline spline(3, controlPoints, ClampedUniformKnots<float>(controlPoints.size(), 3));
+        spline.curve(nbU, out);
+        CHECK(sameBits(out, spline.curve(nbU)));
+
+        std::vector<float> weights = {1, 0.5f, 2, 1, 0.75f, 1};
+        BSpline nurbs(2, controlPoints, ClampedUniformKnots<float>(controlPoints.size(), 2), weights);
+        nurbs.curve(nbU, out);
+        CHECK(sameBits(out, nurbs.curve(nbU)));
+
+        BSplineT<double> precise(3, std::vector<Vec3T<double> >(controlPoints.begin(), controlPoints.end()),
+                                 ClampedUniformKnots<double>(controlPoints.size(), 3));
+        std::vector<Vec3T<double> > precisePoints = precise.curve(nbU);
+        std::vector<Vec3> rounded;
+
+        for (const Vec3T<double> &p : precisePoints) {
+            rounded.push_back(Vec3(p));
+        }
+
+        precise.curve(nbU, out);
+        CHECK(sameBits(out, rounded));
+    }
+
+    // Empty curves and a malformed Hermite entry, as TessellatedBatch fills them
+    CurveBatch curves;
+    curves.addCurve(controlPoints);
+    curves.addCurve(std::vector<Vec3>());
+    curves.addCurve(std::vector<Vec3>(controlPoints.begin(), controlPoints.begin() + 4));
+    curves.addCurve(std::vector<Vec3>(controlPoints.begin(), controlPoints.begin() + 3));
+
+    ThreadPool pool(2);
+
+    for (CurveEngine engine : {ENGINE_CASTELJAU, ENGINE_BERNSTEIN, ENGINE_HERMITE}) {
+        for (long nbU : {0L, 17L}) {
+            TessellatedBatch batch = TessellateBatch(curves, engine, nbU, pool);
+            std::vector<size_t> offsets;
+
+            TessellateBatch(curves, engine, nbU, pool, out, offsets);
+
+            CHECK(offsets == batch.offsets);
+            CHECK(sameBits(out, batch.points));
+        }
+    }
+}
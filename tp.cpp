@@ -89,8 +89,12 @@ void init() {
 }
 
 
+#include "Hermite/hermite.h"
+#include "Berstein/berstein.h"
+#include "Casteljau/casteljau.h"
+
 std::vector<Vec3> controlPoints;
-std::vector<std::vector<Vec3> > constructionPoints;
+CasteljauPyramid constructionPoints;
 std::vector<Vec3> curvePoints;
 
 void setupControlPoints() {
@@ -104,33 +108,14 @@ void setupControlPoints() {
 }
 
 void setupConstructionPointsFor(float u) {
-    std::vector<Vec3> subControlPoints;
-    std::vector<Vec3> nextSubControlPoints = controlPoints;
-
-    while (nextSubControlPoints.size() > 1) {
-        subControlPoints = nextSubControlPoints;
-        nextSubControlPoints.clear();
-
-        for (int i = 0; i < subControlPoints.size() - 1; i++) {
-            Vec3 point;
-            Vec3 v = subControlPoints[i + 1] - subControlPoints[i];
-            v *= u;
-
-            point = subControlPoints[i] + v;
-
-            nextSubControlPoints.push_back(point);
-        }
-
-        constructionPoints.push_back(nextSubControlPoints);
-    }
+    constructionPoints.compute(controlPoints, u);
 }
 
-#include "Hermite/hermite.h"
-#include "Berstein/berstein.h"
-#include "Casteljau/casteljau.h"
+// Largest distance, in world units, between the drawn polyline and the curve
+static const float CURVE_TOLERANCE = 1e-3;
 
 void setupCurvePoints() {
-    curvePoints = BezierCurveByCasteljau(controlPoints, 100);
+    curvePoints = BezierCurveAdaptive(controlPoints, CURVE_TOLERANCE);
 }
 
 void update() {
@@ -141,20 +126,24 @@ void update() {
 // Rendering.
 // ------------------------------------
 
-void drawCurve(const std::vector<Vec3> &points) {
+void drawCurve(const Vec3 *points, size_t count) {
     glBegin(GL_LINE_STRIP);
 
-    for (const Vec3 &point: points) {
+    for (size_t i = 0; i < count; i++) {
         glVertex3f(
-                point[0],
-                point[1],
-                point[2]
+                points[i][0],
+                points[i][1],
+                points[i][2]
         );
     }
 
     glEnd();
 }
 
+void drawCurve(const std::vector<Vec3> &points) {
+    drawCurve(points.data(), points.size());
+}
+
 void drawCircle(const Vec3 &center, float radius) {
     glBegin(GL_POLYGON);
 
@@ -172,15 +161,18 @@ void drawCircle(const Vec3 &center, float radius) {
 }
 
 void drawConstructionLines() {
-    for (int i = 0; i < constructionPoints.size(); i++) {
+    // Level 0 is the control polygon, drawn on its own
+    int nbLevels = (int) constructionPoints.nbLevels() - 1;
+
+    for (int i = 0; i < nbLevels; i++) {
 
         glColor3f(
-            -.8*(float) (1 + i) / (float) constructionPoints.size() + 1,
-            .8*(float) (1 + i) / (float) constructionPoints.size() + .2,
+            -.8*(float) (1 + i) / (float) nbLevels + 1,
+            .8*(float) (1 + i) / (float) nbLevels + .2,
             .2
         );
 
-       drawCurve(constructionPoints[i]);
+       drawCurve(constructionPoints.level(i + 1), constructionPoints.levelSize(i + 1));
     }
 }
 